@@ -1,5 +1,6 @@
 #include "Actor.h"
 #include "StudentWorld.h"
+#include "Trig.h"
 #include <cmath>
 #include <iostream>
 using namespace std;
@@ -7,8 +8,7 @@ using namespace std;
 /* 
  * Initalize Actor
  * @param ptr: a ptr to the StudentWorld the actor is in
- * @param canCollideGR: can actor collide with GhostRacer
- * @param isCAW: is Collision-avoidance worthy actor
+ * @param type: concrete type of actor; collision, CAW and depth traits come from ACTOR_TRAITS
  * @param startXSpeed: initial horizontal speed
  * @param startYSpeed: initial vertical speed
  * @param imageID: imageID of actor
@@ -16,43 +16,84 @@ using namespace std;
  * @param startY: starting Y coordinate
  * @param dir: starting direction
  * @param size: size of actor
- * @param depth: determines which actor gets screen priority
- * @param startHP: initial HP of actor (-1 if doesn't have HP)
  */
-Actor::Actor(StudentWorld *ptr, bool canCollideGR, bool canCollideWater, bool isCAW, double startXSpeed, double startYSpeed, int imageID, double startX, double startY, int dir, double size, unsigned int depth)
-    : GraphObject(imageID, startX, startY, dir, size, depth), m_worldPtr(ptr), m_canCollideGR(canCollideGR), m_canColllideWater(canCollideWater), m_CAW(isCAW), m_horizSpeed(startXSpeed), m_isAlive(true), m_vertSpeed(startYSpeed)
+Actor::Actor(StudentWorld *ptr, ActorType type, double startXSpeed, double startYSpeed, int imageID, double startX, double startY, int dir, double size)
+    : GraphObject(ptr->scene(), imageID, startX, startY, dir, size, actorTraits(type).depth), m_worldPtr(ptr), m_store(&ptr->store()), m_random(ptr->nextEntityId())
 {
+    // the world's store owns the actor from here on
+    m_slot = m_store->add(this, type, 0, startX, startY, startXSpeed, startYSpeed, GraphObject::getRadius());
 }
 Actor::~Actor() {}
 
 // self explanatory methods not commented
+double Actor::getX() const
+{
+    return m_store->x(m_slot);
+}
+double Actor::getY() const
+{
+    return m_store->y(m_slot);
+}
+void Actor::moveTo(double x, double y)
+{
+    m_store->setPosition(m_slot, x, y);
+    increaseAnimationNumber();
+}
+double Actor::getRadius() const
+{
+    return m_store->radius(m_slot);
+}
+ActorHandle Actor::getHandle() const
+{
+    return m_store->handleOf(m_slot);
+}
+size_t Actor::getSlot() const
+{
+    return m_slot;
+}
+ActorType Actor::getType() const
+{
+    return m_store->type(m_slot);
+}
+const ActorTraits &Actor::getTraits() const
+{
+    return actorTraits(getType());
+}
 bool Actor::canCollideGR() const
 {
-    return m_canCollideGR;
+    return getTraits().canCollideGR;
 }
 bool Actor::canCollideWater() const
 {
-    return m_canColllideWater;
+    return getTraits().canCollideWater;
 }
 StudentWorld *Actor::getWorld() const
 {
     return m_worldPtr;
 }
+ActorStore *Actor::getStore() const
+{
+    return m_store;
+}
+int Actor::randInt(int min, int max)
+{
+    return m_random.randInt(m_worldPtr->seed(), m_worldPtr->currentTick(), min, max);
+}
 double Actor::getHorizSpeed() const
 {
-    return m_horizSpeed;
+    return m_store->horizSpeed(m_slot);
 }
 double Actor::getVertSpeed() const
 {
-    return m_vertSpeed;
+    return m_store->vertSpeed(m_slot);
 }
 bool Actor::isAlive() const
 {
-    return m_isAlive;
+    return m_store->hasFlags(m_slot, ActorStore::ALIVE);
 }
 bool Actor::isCAW() const
 {
-    return m_CAW;
+    return getTraits().isCAW;
 }
 
 /*Returns true if Actor is offscreen*/
@@ -80,34 +121,40 @@ bool Actor::isOverlappingGR() const
 
 void Actor::setHorizSpeed(double speed)
 {
-    m_horizSpeed = speed;
+    m_store->setHorizSpeed(m_slot, speed);
 }
 void Actor::setVertSpeed(double speed)
 {
-    m_vertSpeed = speed;
+    m_store->setVertSpeed(m_slot, speed);
 }
 void Actor::setIsAlive(bool isAlive)
 {
-    m_isAlive = isAlive;
+    m_store->setFlag(m_slot, ActorStore::ALIVE, isAlive);
 }
 
-/* Base movement algorithm that updates position based on speeds */
-void Actor::move()
+// most actors have nothing to do before moving
+void Actor::beforeMove() {}
+
+/* Runs once the movement kernel has moved the actor */
+void Actor::planAfterMove()
 {
-    // actor's vert speed depends on ghost racer's vert speed
-    double newVertSpeed = getVertSpeed() - getWorld()->getGR()->getVertSpeed();
-    double newY = getY() + newVertSpeed;
-    double newX = getX() + getHorizSpeed();
-    moveTo(newX, newY);
+    // the kernel writes the store directly, so count the move for animation here
+    increaseAnimationNumber();
 }
 
-Agent::Agent(StudentWorld *ptr, bool canCollideGR, bool canCollideWater, double startYSpeed, int imageID, double startX, double startY, int dir, double size, double startHP)
-    : Actor(ptr, canCollideGR, canCollideWater, IS_CAW, START_X_SPEED, startYSpeed, imageID, startX, startY, dir, size, DEPTH), m_hp(startHP), m_initHp(startHP), m_movementPlan(INIT_MOVEMENT_PLAN) {}
+// most actors have nothing left to do once planned
+void Actor::afterMove() {}
+
+Agent::Agent(StudentWorld *ptr, ActorType type, double startYSpeed, int imageID, double startX, double startY, int dir, double startHP)
+    : Actor(ptr, type, START_X_SPEED, startYSpeed, imageID, startX, startY, dir, actorTraits(type).size), m_initHp(startHP), m_movementPlan(INIT_MOVEMENT_PLAN)
+{
+    getStore()->setHP(getSlot(), startHP);
+}
 Agent::~Agent() {}
 
 int Agent::getHP() const
 {
-    return m_hp;
+    return getStore()->hp(getSlot());
 }
 
 /* Heal up to init hp by @param heal */
@@ -116,9 +163,9 @@ void Agent::healHP(int heal)
     // only heal if amt > 0
     if (heal > 0)
     {
-        int newHp = m_hp + heal;
+        int newHp = getHP() + heal;
         // heal up to max of init hp
-        m_hp = (newHp > m_initHp) ? m_initHp : newHp;
+        getStore()->setHP(getSlot(), (newHp > m_initHp) ? m_initHp : newHp);
     }
 }
 
@@ -128,39 +175,16 @@ void Agent::takeDamage(int damage)
     // deal damage
     if (damage > 0)
     {
-        m_hp -= damage;
+        getStore()->setHP(getSlot(), getHP() - damage);
     }
 
     // if out of HP, set to dead
-    if (m_hp <= 0)
+    if (getHP() <= 0)
     {
         setIsAlive(false);
     }
 }
 
-/* Base movement plan used by Pedestrians */
-void Agent::newMovementPlan()
-{
-    --m_movementPlan;
-    if (m_movementPlan > 0)
-    {
-        return;
-    }
-
-    double newHorizSpeed = (randInt(0, 1) == 0) ? randInt(-Y_SPEED_UPPER_BOUND, -Y_SPEED_LOWER_BOUND) : randInt(Y_SPEED_LOWER_BOUND, Y_SPEED_UPPER_BOUND);
-    setHorizSpeed(newHorizSpeed);
-    m_movementPlan = randInt(MOVEMENT_PLAN_LOWER_BOUND, MOVEMENT_PLAN_UPPER_BOUND);
-
-    if (getHorizSpeed() < 0)
-    {
-        setDirection(LEFT_DIR);
-    }
-    else
-    {
-        setDirection(RIGHT_DIR);
-    }
-}
-
 int Agent::getMovementPlan() const
 {
     return m_movementPlan;
@@ -171,7 +195,11 @@ void Agent::setMovementPlan(int movementPlan)
 }
 
 GhostRacer::GhostRacer(StudentWorld *ptr)
-    : Agent(ptr, CAN_COLLIDE_GR, CAN_COLLIDE_WATER, START_Y_SPEED, IID_GHOST_RACER, START_X, START_Y, START_DIR, SIZE, INIT_HP), m_sprayCount(INIT_WATER_COUNT) {}
+    : Agent(ptr, TYPE, START_Y_SPEED, IID_GHOST_RACER, START_X, START_Y, START_DIR, INIT_HP), m_sprayCount(INIT_WATER_COUNT), m_queuedSprays(0)
+{
+    // GR outlives its own death so StudentWorld can report it
+    getStore()->setFlag(getSlot(), ActorStore::PERSISTENT, true);
+}
 
 GhostRacer::~GhostRacer() {}
 
@@ -258,23 +286,52 @@ void GhostRacer::makeSpray()
     if (m_sprayCount >= 1)
     {
         // determine starting pos of spray
-        double sprayX = getX() + SPRITE_HEIGHT * cos(DEG_2_RAD * getDirection());
-        double sprayY = getY() + SPRITE_HEIGHT * sin(DEG_2_RAD * getDirection());
-        HolyWater *projectile = new HolyWater(getWorld(), IID_HOLY_WATER_PROJECTILE, sprayX, sprayY, getDirection());
-        getWorld()->addActor(projectile);
+        double sprayX = getX() + SPRITE_HEIGHT * cosDegrees(getDirection());
+        double sprayY = getY() + SPRITE_HEIGHT * sinDegrees(getDirection());
+        if (!getWorld()->sprayHolyWater(sprayX, sprayY, getDirection()))
+        {
+            return;
+        }
         getWorld()->playSound(SOUND_PLAYER_SPRAY);
         decrementSprayCount();
     }
 }
 
+/* Remember a space press, up to as many as we have water for and the projectile ring has room for */
+void GhostRacer::queueSpray()
+{
+    int room = static_cast<int>(ProjectileRing::CAPACITY - getWorld()->projectiles().size());
+    if (m_queuedSprays < min(m_sprayCount, room))
+    {
+        ++m_queuedSprays;
+    }
+}
+
+/* Spray the oldest queued press if @param sprays this tick leave room; the ring is sized for SPRAYS_PER_TICK */
+void GhostRacer::sprayQueued(int &sprays)
+{
+    if (m_queuedSprays > 0 && sprays < ProjectileRing::SPRAYS_PER_TICK)
+    {
+        makeSpray();
+        --m_queuedSprays;
+        ++sprays;
+    }
+}
+
 /* Apply user input to Ghost Racer movement */
 void GhostRacer::applyUserInput()
 {
-    int ch;
-    // if user presses key, change car action
-    if (getWorld()->getKey(ch))
-    {
-        switch (ch)
+    // every key pressed since input was last taken, in order, so quick taps
+    // aren't lost; ticks that rebound off a border or find us dead don't take
+    // any, so presses wait for the next tick that does
+    getWorld()->pollInput();
+    const InputState &input = getWorld()->input();
+    int sprays = 0;
+    // space pressed faster than we can spray carries over from earlier ticks
+    sprayQueued(sprays);
+    for (int i = 0; i < input.numPresses(); ++i)
+    {
+        switch (input.press(i))
         {
         case KEY_PRESS_LEFT:
             if (getDirection() < LEFT_ANGLE_TURN_LIMIT)
@@ -303,7 +360,8 @@ void GhostRacer::applyUserInput()
             }
             break;
         case KEY_PRESS_SPACE:
-            makeSpray();
+            queueSpray();
+            sprayQueued(sprays);
             break;
         }
     }
@@ -313,44 +371,30 @@ void GhostRacer::applyUserInput()
 void GhostRacer::move()
 {
     // determine change in X pos
-    double deltaX = cos(DEG_2_RAD * getDirection()) * MAX_SHIFT_PER_TICK;
+    double deltaX = cosDegrees(getDirection()) * MAX_SHIFT_PER_TICK;
     moveTo(getX() + deltaX, getY());
 }
 
-StaticActor::StaticActor(StudentWorld *ptr, bool canCollideGR, bool canCollideWater, int imageID, double startX, double startY, int dir, double size)
-    : Actor(ptr, canCollideGR, canCollideWater, IS_CAW, START_X_SPEED, START_Y_SPEED, imageID, startX, startY, dir, size, DEPTH) {}
-
-StaticActor::~StaticActor() {}
-
-/* Static Actor's action each tick */
-void StaticActor::doSomething()
+StaticActor::StaticActor(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY, int dir, double size)
+    : Actor(ptr, type, START_X_SPEED, START_Y_SPEED, imageID, startX, startY, dir, size)
 {
-    move();
-
-    // set dead if offscreen
-    if (isOffScreen())
-    {
-        setIsAlive(false);
-        return;
-    }
-
-    // deal with GR collision
-    if (canCollideGR() && isOverlappingGR())
-    {
-        onCollideGR();
-    }
+    // we only ever move with the road, so the world can tell when we'll leave the screen
+    ptr->scheduleExit(this);
 }
 
+StaticActor::~StaticActor() {}
+
 BorderLine::BorderLine(StudentWorld *ptr, int imageID, double startX, double startY)
-    : StaticActor(ptr, CAN_COLLIDE_GR, CAN_COLLIDE_WATER, imageID, startX, startY, START_DIR, SIZE) {}
+    : StaticActor(ptr, TYPE, imageID, startX, startY, START_DIR, actorTraits(TYPE).size) {}
 BorderLine::~BorderLine() {}
 
 // Borderline does not collide with GR or water, has no death properties
 void BorderLine::onCollideGR() {}
 void BorderLine::onCollideWater() {}
 
+// size comes from the world's stream, since ours doesn't exist until the base is built
 OilSlick::OilSlick(StudentWorld *ptr, double startX, double startY)
-    : StaticActor(ptr, CAN_COLLIDE_GR, CAN_COLLIDE_WATER, IID_OIL_SLICK, startX, startY, START_DIR, randInt(SIZE_LOWER_BOUND, SIZE_UPPER_BOUND)) {}
+    : StaticActor(ptr, TYPE, IID_OIL_SLICK, startX, startY, START_DIR, ptr->randInt(SIZE_LOWER_BOUND, SIZE_UPPER_BOUND)) {}
 OilSlick::~OilSlick() {}
 
 /* Oil Slick action on collision with Ghost Racer*/
@@ -364,8 +408,8 @@ void OilSlick::onCollideGR()
 // Oil slick does nothing on collision with water or on death
 void OilSlick::onCollideWater() {}
 
-Goodie::Goodie(StudentWorld *ptr, bool canCollideWater, int imageID, double startX, double startY, int dir, double size, int scoreIncrement, int onCollectSound)
-    : StaticActor(ptr, CAN_COLLIDE_GR, canCollideWater, imageID, startX, startY, dir, size), m_scoreIncrement(scoreIncrement), m_collectSound(onCollectSound) {}
+Goodie::Goodie(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY, int dir, int scoreIncrement, int onCollectSound)
+    : StaticActor(ptr, type, imageID, startX, startY, dir, actorTraits(type).size), m_scoreIncrement(scoreIncrement), m_collectSound(onCollectSound) {}
 Goodie::~Goodie() {}
 
 void Goodie::onCollideGR()
@@ -378,7 +422,7 @@ void Goodie::onCollideGR()
 }
 
 Soul::Soul(StudentWorld *ptr, double startX, double startY)
-    : Goodie(ptr, CAN_COLLIDE_WATER, IID_SOUL_GOODIE, startX, startY, START_DIR, SIZE, SCORE_INCREMENT, SOUND_GOT_SOUL) {}
+    : Goodie(ptr, TYPE, IID_SOUL_GOODIE, startX, startY, START_DIR, SCORE_INCREMENT, SOUND_GOT_SOUL) {}
 Soul::~Soul() {}
 
 void Soul::incrementStat()
@@ -387,14 +431,14 @@ void Soul::incrementStat()
 }
 
 void Soul::onCollideWater() {}
-void Soul::move()
+void Soul::planAfterMove()
 {
-    Actor::move();
+    Actor::planAfterMove();
     setDirection(getDirection() - ANG_SPEED); // rotate soul
 }
 
-DamageableGoodie::DamageableGoodie(StudentWorld *ptr, int imageID, double startX, double startY, int dir, double size, int scoreIncrement)
-    : Goodie(ptr, CAN_COLLIDE_WATER, imageID, startX, startY, dir, size, scoreIncrement, ON_COLLECT_SOUND) {}
+DamageableGoodie::DamageableGoodie(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY, int dir, int scoreIncrement)
+    : Goodie(ptr, type, imageID, startX, startY, dir, scoreIncrement, ON_COLLECT_SOUND) {}
 DamageableGoodie::~DamageableGoodie() {}
 
 void DamageableGoodie::onCollideWater()
@@ -403,7 +447,7 @@ void DamageableGoodie::onCollideWater()
 }
 
 HealGoodie::HealGoodie(StudentWorld *ptr, double startX, double startY)
-    : DamageableGoodie(ptr, IID_HEAL_GOODIE, startX, startY, START_DIR, SIZE, SCORE_INCREMENT) {}
+    : DamageableGoodie(ptr, TYPE, IID_HEAL_GOODIE, startX, startY, START_DIR, SCORE_INCREMENT) {}
 HealGoodie::~HealGoodie() {}
 
 void HealGoodie::incrementStat()
@@ -412,7 +456,7 @@ void HealGoodie::incrementStat()
 }
 
 WaterGoodie::WaterGoodie(StudentWorld *ptr, double startX, double startY)
-    : DamageableGoodie(ptr, IID_HOLY_WATER_GOODIE, startX, startY, START_DIR, SIZE, SCORE_INCREMENT) {}
+    : DamageableGoodie(ptr, TYPE, IID_HOLY_WATER_GOODIE, startX, startY, START_DIR, SCORE_INCREMENT) {}
 WaterGoodie::~WaterGoodie() {}
 
 void WaterGoodie::incrementStat()
@@ -420,44 +464,36 @@ void WaterGoodie::incrementStat()
     getWorld()->getGR()->addSprays(SPRAY_INCREMENT);
 }
 
-Pedestrian::Pedestrian(StudentWorld *ptr, int imageID, double startX, double startY, double size)
-    : Agent(ptr, CAN_COLLIDE_GR, CAN_COLLIDE_WATER, START_Y_SPEED, imageID, startX, startY, START_DIR, size, INIT_HP) {}
+Pedestrian::Pedestrian(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY)
+    : Agent(ptr, type, START_Y_SPEED, imageID, startX, startY, START_DIR, INIT_HP)
+{
+    // pick the first movement plan on our first tick
+    ptr->scheduleMovementPlan(this, INIT_MOVEMENT_PLAN + 1);
+}
 Pedestrian::~Pedestrian() {}
 
-void Pedestrian::doSomething()
+/* Start a new movement plan and return how many ticks it lasts */
+int Pedestrian::newMovementPlan()
 {
-    if (!isAlive())
-    {
-        return;
-    }
+    double newHorizSpeed = (randInt(0, 1) == 0) ? randInt(-Y_SPEED_UPPER_BOUND, -Y_SPEED_LOWER_BOUND) : randInt(Y_SPEED_LOWER_BOUND, Y_SPEED_UPPER_BOUND);
+    setHorizSpeed(newHorizSpeed);
+    int movementPlan = randInt(MOVEMENT_PLAN_LOWER_BOUND, MOVEMENT_PLAN_UPPER_BOUND);
 
-    // deal with GR collision
-    if (isOverlappingGR())
+    if (getHorizSpeed() < 0)
     {
-        onCollideGR();
-        return;
+        setDirection(LEFT_DIR);
     }
-
-    // deal with movement and aggroing GR
-    aggroGR();
-    move();
-
-    // kill ped if offscreen
-    if (isOffScreen())
+    else
     {
-        setIsAlive(false);
-        return;
+        setDirection(RIGHT_DIR);
     }
-
-    newMovementPlan();
+    return movementPlan;
 }
 
 HumanPedestrian::HumanPedestrian(StudentWorld *ptr, double startX, double startY)
-    : Pedestrian(ptr, IID_HUMAN_PED, startX, startY, SIZE) {}
+    : Pedestrian(ptr, TYPE, IID_HUMAN_PED, startX, startY) {}
 HumanPedestrian::~HumanPedestrian() {}
 
-void HumanPedestrian::aggroGR() {} // human doesn't aggro GR, so will be empty
-
 // lets studentworld know human was hit
 void HumanPedestrian::onCollideGR()
 {
@@ -473,9 +509,28 @@ void HumanPedestrian::onCollideWater()
 }
 
 ZombiePedestrian::ZombiePedestrian(StudentWorld *ptr, double startX, double startY)
-    : Pedestrian(ptr, IID_ZOMBIE_PED, startX, startY, SIZE), m_gruntTicks(INIT_GRUNT_TICKS) {}
+    : Pedestrian(ptr, TYPE, IID_ZOMBIE_PED, startX, startY), m_gruntTicks(INIT_GRUNT_TICKS), m_gruntPending(false) {}
 ZombiePedestrian::~ZombiePedestrian() {}
 
+/* Aggro GR before moving, so the new speed applies to this tick's move */
+void ZombiePedestrian::beforeMove()
+{
+    aggroGR();
+    if (getWorld()->swarmSteering())
+    {
+        steerWithSwarm();
+    }
+}
+
+void ZombiePedestrian::afterMove()
+{
+    if (m_gruntPending)
+    {
+        getWorld()->playSound(SOUND_ZOMBIE_ATTACK);
+        m_gruntPending = false;
+    }
+}
+
 void ZombiePedestrian::aggroGR()
 {
     GhostRacer *gr = getWorld()->getGR();
@@ -504,11 +559,47 @@ void ZombiePedestrian::aggroGR()
         decrementGruntTicks();
         if (m_gruntTicks <= 0)
         {
-            getWorld()->playSound(SOUND_ZOMBIE_ATTACK);
+            m_gruntPending = true;
             resetGruntTicks();
         }
     }
 }
+
+/*
+ * Nudge our sideways speed away from the nearest few zombies and from any cab
+ * bearing down, harder the closer they are. Only vertical speed is fixed, so
+ * the swarm spreads across the road rather than along it.
+ */
+void ZombiePedestrian::steerWithSwarm()
+{
+    const SpatialGrid &index = getWorld()->spatialIndex();
+    size_t self = getSlot();
+    double push = 0;
+
+    SpatialGrid::Neighbour neighbours[SWARM_NEIGHBOURS];
+    int count = index.nearestInRadius(getX(), getY(), SWARM_RADIUS, 1u << ACTOR_ZOMBIE_PED, self, SWARM_NEIGHBOURS, neighbours);
+    for (int i = 0; i < count; i++)
+    {
+        double distance = sqrt(neighbours[i].distanceSq);
+        if (distance > 0)
+        {
+            push -= neighbours[i].dx / distance * (1 - distance / SWARM_RADIUS) * SEPARATION_PUSH;
+        }
+    }
+    index.forEachInRadius(getX(), getY(), CAB_AVOID_RADIUS, 1u << ACTOR_ZOMBIE_CAB, [&](size_t, double dx, double dy) {
+        double distance = sqrt(dx * dx + dy * dy);
+        // dead ahead of a cab, dodge the way we're already going
+        double away = (dx != 0) ? -dx / distance : ((getHorizSpeed() < 0) ? -1 : 1);
+        push += away * (1 - distance / CAB_AVOID_RADIUS) * CAB_PUSH;
+        return true;
+    });
+
+    if (push != 0)
+    {
+        setHorizSpeed(max(-MAX_SWARM_X_SPEED, min(MAX_SWARM_X_SPEED, getHorizSpeed() + push)));
+    }
+}
+
 void ZombiePedestrian::onCollideGR()
 {
     // take damage, give GR damage, increase score
@@ -519,7 +610,7 @@ void ZombiePedestrian::onCollideGR()
 }
 void ZombiePedestrian::onCollideWater()
 {
-    takeDamage(HolyWater::DAMAGE);
+    takeDamage(ProjectileRing::DAMAGE);
     if (getHP() <= 0)
     {
         getWorld()->playSound(SOUND_PED_DIE);
@@ -527,8 +618,7 @@ void ZombiePedestrian::onCollideWater()
         // if didn't die to GR, 1/5 chance spawn healgoodie
         if (!isOverlappingGR() && randInt(1, 5) == 1)
         {
-            HealGoodie *healGoodie = new HealGoodie(getWorld(), getX(), getY());
-            getWorld()->addActor(healGoodie);
+            getWorld()->spawn<HealGoodie>(getX(), getY());
         }
         getWorld()->increaseScore(SCORE_INCREMENT);
     }
@@ -548,53 +638,8 @@ void ZombiePedestrian::resetGruntTicks()
     m_gruntTicks = RESET_GRUNT_TICKS;
 }
 
-HolyWater::HolyWater(StudentWorld *ptr, int imageID, double startX, double startY, int dir)
-    : Actor(ptr, CAN_COLLIDE_GR, CAN_COLLIDE_WATER, IS_CAW, START_X_SPEED, START_Y_SPEED, IID_HOLY_WATER_PROJECTILE, startX, startY, dir, SIZE, DEPTH), m_travel(0) {}
-HolyWater::~HolyWater() {}
-
-void HolyWater::onCollideGR() {}
-void HolyWater::onCollideWater() {}
-
-void HolyWater::doSomething()
-{
-    if (!isAlive())
-    {
-        return;
-    }
-
-    // if projectile hits hittable actor, kill the projectile
-    // studentworld takes care of dealing damage to other actor
-    if (getWorld()->checkProjectileHit(this))
-    {
-        setIsAlive(false);
-        return;
-    }
-
-    move();
-    if (isOffScreen())
-    {
-        setIsAlive(false);
-        return;
-    }
-
-    // kill projectile if traveled too much
-    if (m_travel >= MAX_TRAVEL_DIST)
-    {
-        setIsAlive(false);
-    }
-}
-void HolyWater::move()
-{
-    moveForward(SPRITE_HEIGHT);
-    updateTravel();
-}
-void HolyWater::updateTravel()
-{
-    m_travel += SPRITE_HEIGHT;
-}
-
 ZombieCab::ZombieCab(StudentWorld *ptr, double startYSpeed, double startX, double startY)
-    : Agent(ptr, CAN_COLLIDE_GR, CAN_COLLIDE_WATER, startYSpeed, IID_ZOMBIE_CAB, startX, startY, START_DIR, SIZE, INIT_HP), m_hasDamagedGR(DAMAGED_GR) {}
+    : Agent(ptr, TYPE, startYSpeed, IID_ZOMBIE_CAB, startX, startY, START_DIR, INIT_HP), m_hasDamagedGR(DAMAGED_GR) {}
 ZombieCab::~ZombieCab() {}
 
 void ZombieCab::onCollideGR()
@@ -629,7 +674,7 @@ void ZombieCab::onCollideGR()
 }
 void ZombieCab::onCollideWater()
 {
-    takeDamage(HolyWater::DAMAGE);
+    takeDamage(ProjectileRing::DAMAGE);
 
     if (getHP() < 0)
     {
@@ -638,8 +683,7 @@ void ZombieCab::onCollideWater()
         // 1/5 chance of adding oil slick
         if (randInt(1, 5) == 1)
         {
-            OilSlick *oil = new OilSlick(getWorld(), getX(), getY());
-            getWorld()->addActor(oil);
+            getWorld()->spawn<OilSlick>(getX(), getY());
         }
         // increment score and return
         getWorld()->increaseScore(SCORE_INCREMENT);
@@ -651,37 +695,23 @@ void ZombieCab::onCollideWater()
         getWorld()->playSound(SOUND_VEHICLE_HURT);
     }
 }
-void ZombieCab::doSomething()
+/* Adjust speed once moved; cabs that left the screen are already dead */
+void ZombieCab::planAfterMove()
 {
-    if (!isAlive())
-    {
-        return;
-    }
-
-    // handle GR interaction
-    if (isOverlappingGR())
-    {
-        onCollideGR();
-    }
+    Actor::planAfterMove();
 
-    move();
-    if (isOffScreen())
-    {
-        setIsAlive(false);
-        return;
-    }
-
-    // make vert speed change and return if change made
+    // make vert speed change and return if change made; only other
+    // actors' positions are read, and nothing moves them until next tick
     if (vertSpeedAdjustment())
     {
         return;
-    };
+    }
 
     // keep track of movement plan
     newMovementPlan();
 }
 
-double ZombieCab::getRandomDirectionShift() const
+double ZombieCab::getRandomDirectionShift()
 {
     return randInt(0, RAND_DIRECTION_RANGE - 1);
 }
@@ -712,30 +742,10 @@ bool ZombieCab::vertSpeedAdjustment()
     return false;
 }
 
-/* Determine which lane zombiecab is in */
+/* Determine which lane zombiecab is in, or -1 off the road */
 int ZombieCab::getLane() const
 {
-    // left Lane
-    if (getX() >= StudentWorld::ROAD_LEFT_EDGE && getX() < StudentWorld::LEFT_DIVIDER_X)
-    {
-        return 1;
-    }
-    // mid lane
-    else if (getX() >= StudentWorld::LEFT_DIVIDER_X && getX() < StudentWorld::RIGHT_DIVIDER_X)
-    {
-        return 2;
-    }
-
-    // right lane
-    else if (getX() >= StudentWorld::RIGHT_DIVIDER_X && getX() < StudentWorld::ROAD_RIGHT_EDGE)
-    {
-        return 3;
-    }
-    // not on the road
-    else
-    {
-        return -1;
-    }
+    return ROAD.laneAt(getX());
 }
 /* Update cab's movement plan and create new one if necessary*/
 void ZombieCab::newMovementPlan()
@@ -752,7 +762,7 @@ void ZombieCab::newMovementPlan()
 }
 
 /* Random speed modifier on movement plan */
-double ZombieCab::getRandomSpeedModifier() const
+double ZombieCab::getRandomSpeedModifier()
 {
     return randInt(-MOVEMENT_PLAN_SPEED_MODIFER, MOVEMENT_PLAN_SPEED_MODIFER);
 }
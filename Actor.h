@@ -2,6 +2,9 @@
 #define ACTOR_H_
 
 #include "GraphObject.h"
+#include "ActorStore.h"
+#include "ActorTraits.h"
+#include "Random.h"
 
 class StudentWorld;
 
@@ -11,9 +14,19 @@ public:
     static constexpr double X_SCALE = 0.25;
     static constexpr double Y_SCALE = 0.6;
 
-    Actor(StudentWorld *ptr, bool canCollideGR, bool canCollideWater, bool isCAW, double startXSpeed, double startYSpeed, int imageID, double startX, double startY, int dir, double size, unsigned int depth);
+    Actor(StudentWorld *ptr, ActorType type, double startXSpeed, double startYSpeed, int imageID, double startX, double startY, int dir, double size);
     virtual ~Actor();
 
+    // position, speeds, flags and HP live in the world's ActorStore
+    virtual double getX() const final;
+    virtual double getY() const final;
+    virtual void moveTo(double x, double y) final;
+    double getRadius() const;
+    ActorHandle getHandle() const;
+    size_t getSlot() const;
+    ActorType getType() const;
+    const ActorTraits &getTraits() const;
+
     bool canCollideGR() const;
     bool canCollideWater() const;
     StudentWorld *getWorld() const;
@@ -29,27 +42,38 @@ public:
     void setVertSpeed(double speed);
     void setIsAlive(bool isAlive);
 
-    // every actor must know how it interacts with GR, Water, and how it moves and does something
+    // every actor must know how it interacts with GR and Water
     virtual void onCollideGR() = 0;
     virtual void onCollideWater() = 0;
-    virtual void doSomething() = 0;
-    virtual void move();
+
+    // Each tick StudentWorld calls beforeMove on every live actor, moves all
+    // scrolling actors at once with the movement kernel, then calls
+    // planAfterMove and afterMove on every actor still alive.
+    // beforeMove and planAfterMove may run on worker threads: they may read
+    // the world and draw from the actor's own random stream, but write only
+    // the actor's own state, and must not play sounds or spawn. afterMove runs
+    // serially in StudentWorld::UpdateOrder and does everything else.
+    virtual void beforeMove();
+    virtual void planAfterMove();
+    virtual void afterMove();
+
+protected:
+    ActorStore *getStore() const;
+    // draw from this actor's own stream; see Random.h
+    int randInt(int min, int max);
 
 private:
-    bool m_canCollideGR;
-    bool m_canColllideWater;
+    friend class ActorStore; // updates m_slot when compacting
+
     StudentWorld *m_worldPtr;
-    double m_horizSpeed;
-    double m_vertSpeed;
-    bool m_isAlive;
-    bool m_CAW;
+    ActorStore *m_store;
+    size_t m_slot;
+    RandomStream m_random;
 };
 
 class Agent : public Actor
 {
 public:
-    static const bool IS_CAW = true;
-    static const unsigned int DEPTH = 0;
     static constexpr double START_X_SPEED = 0;
 
     static const int INIT_MOVEMENT_PLAN = 0;
@@ -60,28 +84,25 @@ public:
     static const int LEFT_DIR = 180;
     static const int RIGHT_DIR = 0;
 
-    Agent(StudentWorld *ptr, bool canCollideGR, bool canCollideWater, double startYSpeed, int imageID, double startX, double startY, int dir, double size, double startHP);
+    Agent(StudentWorld *ptr, ActorType type, double startYSpeed, int imageID, double startX, double startY, int dir, double startHP);
     virtual ~Agent();
 
     // agents have HP and most have movementPlans
     int getHP() const;
     void healHP(int heal);
     void takeDamage(int damage);
-    virtual void newMovementPlan();
     int getMovementPlan() const;
     void setMovementPlan(int movementPlan);
 
 private:
     int m_initHp;
-    int m_hp;
     int m_movementPlan;
 };
 
-class GhostRacer : public Agent
+class GhostRacer final : public Agent
 {
 public:
-    static const bool CAN_COLLIDE_GR = false;
-    static const bool CAN_COLLIDE_WATER = false;
+    static const ActorType TYPE = ACTOR_GHOST_RACER;
 
     static const int INIT_HP = 100;
     static const int START_DIR = up; // degrees
@@ -89,7 +110,6 @@ public:
     static const int REBOUND_LEFT_DIR = 98;
     static const int INIT_WATER_COUNT = 10;
 
-    static constexpr double SIZE = 4;
     static constexpr double START_X = 128;
     static constexpr double START_Y = 32;
     static constexpr double BORDER_DMG = 10;
@@ -103,7 +123,6 @@ public:
     static constexpr double MIN_VERT_SPEED = -1;
     static constexpr double SPEED_INCREMENT = 1;
     static constexpr double MAX_SHIFT_PER_TICK = 4.0;
-    static constexpr double DEG_2_RAD = M_PI / 180;
 
     GhostRacer(StudentWorld *ptr);
     virtual ~GhostRacer();
@@ -115,12 +134,16 @@ public:
 
     virtual void onCollideGR();
     virtual void onCollideWater();
-    virtual void doSomething();
-    virtual void move();
+    // GR isn't scrolled; StudentWorld runs its whole tick here after everyone else
+    void doSomething();
 
 private:
     int m_sprayCount;
+    int m_queuedSprays; // space presses not sprayed yet; at most one goes a tick
+    void move();
     void makeSpray();
+    void queueSpray();
+    void sprayQueued(int &sprays);
     void decrementSprayCount();
     void applyUserInput();
 
@@ -129,24 +152,18 @@ private:
 class StaticActor : public Actor
 {
 public:
-    static const bool IS_CAW = false;
     static constexpr double START_X_SPEED = 0;
     static constexpr double START_Y_SPEED = -4;
-    static const unsigned int DEPTH = 2;
 
-    StaticActor(StudentWorld *ptr, bool canCollideGR, bool canCollideWater, int imageID, double startX, double startY, int dir, double size);
+    StaticActor(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY, int dir, double size);
     virtual ~StaticActor();
-
-    virtual void doSomething();
 };
 
-class BorderLine : public StaticActor
+class BorderLine final : public StaticActor
 {
 public:
+    static const ActorType TYPE = ACTOR_BORDER_LINE;
     static const int START_DIR = 0;
-    static const bool CAN_COLLIDE_GR = false;
-    static const bool CAN_COLLIDE_WATER = false;
-    static constexpr double SIZE = 2;
 
     BorderLine(StudentWorld *ptr, int imageID, double startX, double startY);
     virtual ~BorderLine();
@@ -155,14 +172,13 @@ public:
     virtual void onCollideWater();
 };
 
-class OilSlick : public StaticActor
+class OilSlick final : public StaticActor
 {
 public:
+    static const ActorType TYPE = ACTOR_OIL_SLICK;
     static const int START_DIR = 0;
-    static const bool CAN_COLLIDE_GR = true;
-    static const bool CAN_COLLIDE_WATER = false;
     static const int SIZE_LOWER_BOUND = 2;
-    static const int SIZE_UPPER_BOUND = 5;
+    static constexpr int SIZE_UPPER_BOUND = actorTraits(TYPE).size;
 
     OilSlick(StudentWorld *ptr, double startX, double startY);
     virtual ~OilSlick();
@@ -174,9 +190,7 @@ public:
 class Goodie : public StaticActor
 {
 public:
-    static const bool CAN_COLLIDE_GR = true;
-
-    Goodie(StudentWorld *ptr, bool canCollideWater, int imageID, double startX, double startY, int dir, double size, int scoreIncrement, int onCollectSound);
+    Goodie(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY, int dir, int scoreIncrement, int onCollectSound);
     virtual ~Goodie();
 
     virtual void onCollideGR();
@@ -188,11 +202,10 @@ private:
     int m_collectSound;
 };
 
-class Soul : public Goodie
+class Soul final : public Goodie
 {
 public:
-    static const bool CAN_COLLIDE_WATER = false;
-    static constexpr double SIZE = 4.0;
+    static const ActorType TYPE = ACTOR_SOUL;
     static const int START_DIR = 0;
     static const int SCORE_INCREMENT = 100;
     static const int ANG_SPEED = 10;
@@ -202,26 +215,25 @@ public:
 
     virtual void incrementStat();
     virtual void onCollideWater();
-    virtual void move(); // must redefine move to rotate soul
+    virtual void planAfterMove(); // must redefine to rotate soul
 };
 
 class DamageableGoodie : public Goodie
 {
 public:
-    static const bool CAN_COLLIDE_WATER = true;
     static const int ON_COLLECT_SOUND = SOUND_GOT_GOODIE;
 
-    DamageableGoodie(StudentWorld *ptr, int imageID, double startX, double startY, int dir, double size, int scoreIncrement);
+    DamageableGoodie(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY, int dir, int scoreIncrement);
     virtual ~DamageableGoodie();
 
     virtual void onCollideWater(); // damageable goodies die to water
 };
 
-class HealGoodie : public DamageableGoodie
+class HealGoodie final : public DamageableGoodie
 {
 public:
+    static const ActorType TYPE = ACTOR_HEAL_GOODIE;
     static const int START_DIR = 0;
-    static constexpr double SIZE = 1.0;
     static const int SCORE_INCREMENT = 250;
     static const int HEALTH_INCREMENT = 10;
 
@@ -231,11 +243,11 @@ public:
     virtual void incrementStat();
 };
 
-class WaterGoodie : public DamageableGoodie
+class WaterGoodie final : public DamageableGoodie
 {
 public:
+    static const ActorType TYPE = ACTOR_WATER_GOODIE;
     static const int START_DIR = 90;
-    static constexpr double SIZE = 2.0;
     static const int SCORE_INCREMENT = 50;
     static const int SPRAY_INCREMENT = 10;
 
@@ -251,33 +263,30 @@ public:
     static const int INIT_HP = 2;
     static constexpr double START_Y_SPEED = -4;
     static const int START_DIR = 0;
-    static const bool CAN_COLLIDE_GR = true;
-    static const bool CAN_COLLIDE_WATER = true;
 
-    Pedestrian(StudentWorld *ptr, int imageID, double startX, double startY, double size);
+    Pedestrian(StudentWorld *ptr, ActorType type, int imageID, double startX, double startY);
     virtual ~Pedestrian();
 
-    virtual void doSomething();
-    virtual void aggroGR() = 0; // only used by Zombie Ped
+    // pick a new sideways speed; StudentWorld wakes us for the next one in @return ticks
+    int newMovementPlan();
 };
 
-class HumanPedestrian : public Pedestrian
+class HumanPedestrian final : public Pedestrian
 {
 public:
-    static constexpr double SIZE = 2.0;
+    static const ActorType TYPE = ACTOR_HUMAN_PED;
 
     HumanPedestrian(StudentWorld *ptr, double startX, double startY);
     virtual ~HumanPedestrian();
 
-    virtual void aggroGR(); // human doesn't aggro GR, so will be empty
     virtual void onCollideGR();
     virtual void onCollideWater();
 };
 
-class ZombiePedestrian : public Pedestrian
+class ZombiePedestrian final : public Pedestrian
 {
 public:
-    static constexpr double SIZE = 3.0;
+    static const ActorType TYPE = ACTOR_ZOMBIE_PED;
     static const int INIT_GRUNT_TICKS = 0;
     static const int RESET_GRUNT_TICKS = 20;
     static const int SCORE_INCREMENT = 150;
@@ -286,56 +295,40 @@ public:
     static constexpr double GR_DELTA_X = 30.0;
     static const int ATTACK_GR_DIR = 270;
     static constexpr double ATTACK_GR_X_SPEED = 1.0;
+    // swarm steering (StudentWorld::setSwarmSteering): how close other zombies
+    // and cabs get before we move away, how many zombies we look at, how hard
+    // each pushes us sideways at point blank, and our top sideways speed
+    static constexpr double SWARM_RADIUS = 16.0;
+    static constexpr double CAB_AVOID_RADIUS = 40.0;
+    static const int SWARM_NEIGHBOURS = 8;
+    static constexpr double SEPARATION_PUSH = 0.5;
+    static constexpr double CAB_PUSH = 1.5;
+    static constexpr double MAX_SWARM_X_SPEED = 3.0;
 
     ZombiePedestrian(StudentWorld *ptr, double startX, double startY);
     virtual ~ZombiePedestrian();
 
-    virtual void aggroGR();
+    virtual void beforeMove(); // aggro GR, then steer with the swarm
+    virtual void afterMove();
     virtual void onCollideGR();
     virtual void onCollideWater();
 
 private:
     int m_gruntTicks;
+    bool m_gruntPending; // decided in beforeMove, played in afterMove
+    void aggroGR();
+    void steerWithSwarm();
     void decrementGruntTicks();
     void resetGruntTicks();
 };
 
-class HolyWater : public Actor
-{
-public:
-    static const bool CAN_COLLIDE_GR = false;
-    static const bool CAN_COLLIDE_WATER = false;
-    static const bool IS_CAW = false;
-    static constexpr double START_X_SPEED = 0.0; // unused by class
-    static constexpr double START_Y_SPEED = 0.0; // unused by class
-    static const unsigned int DEPTH = 1;
-    static const int DAMAGE = 1;
-    static constexpr double MAX_TRAVEL_DIST = 160.0;
-    static constexpr double SIZE = 1.0;
-
-    HolyWater(StudentWorld *ptr, int imageID, double startX, double startY, int dir);
-    virtual ~HolyWater();
-
-    virtual void onCollideGR();
-    virtual void onCollideWater();
-    virtual void doSomething();
-    virtual void move();
-
-private:
-    double m_travel;
-
-    void updateTravel();
-};
-
-class ZombieCab : public Agent
+class ZombieCab final : public Agent
 {
 public:
-    static const bool CAN_COLLIDE_GR = true;
-    static const bool CAN_COLLIDE_WATER = true;
+    static const ActorType TYPE = ACTOR_ZOMBIE_CAB;
     static const int START_DIR = 90;
     static const bool DAMAGED_GR = false;
     static const int INIT_HP = 3;
-    static constexpr double SIZE = 4.0;
     static const int SCORE_INCREMENT = 200;
     static const int DMG_TO_GR = 20;
     static constexpr double POST_COLLISION_X_SPEED = 5.0;
@@ -351,15 +344,15 @@ public:
 
     virtual void onCollideGR();
     virtual void onCollideWater();
-    virtual void doSomething();
-    virtual void newMovementPlan();
+    virtual void planAfterMove();
+    void newMovementPlan();
     int getLane() const;
 
 private:
     bool m_hasDamagedGR;
 
-    double getRandomDirectionShift() const;
+    double getRandomDirectionShift();
     bool vertSpeedAdjustment();
-    double getRandomSpeedModifier() const;
+    double getRandomSpeedModifier();
 };
 #endif // ACTOR_H_
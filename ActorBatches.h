@@ -0,0 +1,80 @@
+#ifndef ACTORBATCHES_H_
+#define ACTORBATCHES_H_
+
+#include "ActorStore.h"
+#include <cstddef>
+#include <vector>
+
+class Actor;
+
+// Live actors grouped by concrete type, so an update pass can run one tight
+// loop per type with calls the compiler can resolve statically (the concrete
+// actor classes are final) instead of a virtual call per actor.
+class ActorBatches
+{
+public:
+    /* Regroup the live actors in store slots [begin, size), keeping creation order within each type */
+    void rebuild(const ActorStore &store, size_t begin)
+    {
+        for (std::vector<Actor *> &batch : m_batches)
+        {
+            batch.clear();
+        }
+        const unsigned char *types = store.types();
+        const unsigned char *flags = store.flags();
+        for (size_t slot = begin; slot < store.size(); ++slot)
+        {
+            if (flags[slot] & ActorStore::ALIVE)
+            {
+                m_batches[types[slot]].push_back(store.owner(slot));
+            }
+        }
+    }
+
+    template <typename T>
+    size_t count() const
+    {
+        return m_batches[T::TYPE].size();
+    }
+
+    // call f(actor) with every actor of type T, as a T *
+    template <typename T, typename F>
+    void forEach(F &&f) const
+    {
+        forEachIn<T>(0, count<T>(), f);
+    }
+
+    // same, for batch positions [begin, end) only
+    template <typename T, typename F>
+    void forEachIn(size_t begin, size_t end, F &&f) const
+    {
+        const std::vector<Actor *> &batch = m_batches[T::TYPE];
+        for (size_t i = begin; i < end; ++i)
+        {
+            f(static_cast<T *>(batch[i]));
+        }
+    }
+
+private:
+    std::vector<Actor *> m_batches[NUM_ACTOR_TYPES];
+};
+
+// An ordered list of actor types; forEach visits whole batches in this order
+template <typename... Ts>
+struct ActorTypeList
+{
+    template <typename F>
+    static void forEach(const ActorBatches &batches, F &&f)
+    {
+        (batches.forEach<Ts>(f), ...);
+    }
+
+    // call f((T *)nullptr) once per type, as a tag for generic lambdas
+    template <typename F>
+    static void forEachType(F &&f)
+    {
+        (f(static_cast<Ts *>(nullptr)), ...);
+    }
+};
+
+#endif // ACTORBATCHES_H_
@@ -0,0 +1,127 @@
+#include "ActorStore.h"
+#include "Actor.h"
+using namespace std;
+
+ActorStore::ActorStore() {}
+
+ActorStore::~ActorStore()
+{
+    clear();
+}
+
+/* Append an actor's state as a new slot and give it a handle id */
+size_t ActorStore::add(Actor *owner, ActorType type, unsigned char flags, double x, double y, double horizSpeed, double vertSpeed, double radius)
+{
+    size_t slot = m_owner.size();
+
+    // reuse a freed handle id if there is one
+    unsigned int id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_slotOfId[id] = slot;
+    }
+    else
+    {
+        id = m_slotOfId.size();
+        m_slotOfId.push_back(slot);
+        m_generation.push_back(0);
+    }
+
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_horizSpeed.push_back(horizSpeed);
+    m_vertSpeed.push_back(vertSpeed);
+    m_radius.push_back(radius);
+    m_hp.push_back(0);
+    m_flags.push_back(flags | ALIVE);
+    m_type.push_back(type);
+    m_owner.push_back(owner);
+    m_id.push_back(id);
+    return slot;
+}
+
+/* Returns the actor @param handle refers to, or nullptr if it has been removed */
+Actor *ActorStore::resolve(ActorHandle handle) const
+{
+    if (handle.id >= m_generation.size() || m_generation[handle.id] != handle.generation)
+    {
+        return nullptr;
+    }
+    return m_owner[m_slotOfId[handle.id]];
+}
+
+void ActorStore::removeDead()
+{
+    size_t count = m_owner.size();
+    size_t kept = 0;
+    for (size_t slot = 0; slot < count; ++slot)
+    {
+        if (m_flags[slot] & (ALIVE | PERSISTENT))
+        {
+            if (kept != slot)
+            {
+                moveSlot(slot, kept);
+            }
+            ++kept;
+        }
+        else
+        {
+            // retire the id so stale handles stop resolving
+            ++m_generation[m_id[slot]];
+            m_freeIds.push_back(m_id[slot]);
+            delete m_owner[slot];
+        }
+    }
+
+    m_x.resize(kept);
+    m_y.resize(kept);
+    m_horizSpeed.resize(kept);
+    m_vertSpeed.resize(kept);
+    m_radius.resize(kept);
+    m_hp.resize(kept);
+    m_flags.resize(kept);
+    m_type.resize(kept);
+    m_owner.resize(kept);
+    m_id.resize(kept);
+}
+
+void ActorStore::clear()
+{
+    for (size_t slot = 0; slot < m_owner.size(); ++slot)
+    {
+        ++m_generation[m_id[slot]];
+        m_freeIds.push_back(m_id[slot]);
+        delete m_owner[slot];
+    }
+
+    m_x.clear();
+    m_y.clear();
+    m_horizSpeed.clear();
+    m_vertSpeed.clear();
+    m_radius.clear();
+    m_hp.clear();
+    m_flags.clear();
+    m_type.clear();
+    m_owner.clear();
+    m_id.clear();
+}
+
+/* Copy every array's entry from one slot to another and tell the owner */
+void ActorStore::moveSlot(size_t from, size_t to)
+{
+    m_x[to] = m_x[from];
+    m_y[to] = m_y[from];
+    m_horizSpeed[to] = m_horizSpeed[from];
+    m_vertSpeed[to] = m_vertSpeed[from];
+    m_radius[to] = m_radius[from];
+    m_hp[to] = m_hp[from];
+    m_flags[to] = m_flags[from];
+    m_type[to] = m_type[from];
+    m_owner[to] = m_owner[from];
+    m_id[to] = m_id[from];
+
+    m_slotOfId[m_id[to]] = to;
+    m_owner[to]->m_slot = to;
+}
@@ -0,0 +1,125 @@
+#ifndef ACTORSTORE_H_
+#define ACTORSTORE_H_
+
+#include <cstddef>
+#include <vector>
+
+class Actor;
+
+// concrete actor classes, stored per slot so passes can filter without virtual calls
+enum ActorType : unsigned char
+{
+    ACTOR_GHOST_RACER,
+    ACTOR_BORDER_LINE,
+    ACTOR_OIL_SLICK,
+    ACTOR_SOUL,
+    ACTOR_HEAL_GOODIE,
+    ACTOR_WATER_GOODIE,
+    ACTOR_HUMAN_PED,
+    ACTOR_ZOMBIE_PED,
+    ACTOR_ZOMBIE_CAB,
+    ACTOR_HOLY_WATER,
+    NUM_ACTOR_TYPES
+};
+
+// Stable reference to an actor. Slots move when dead actors are compacted
+// away, handles don't; a handle to a removed actor resolves to nullptr.
+struct ActorHandle
+{
+    unsigned int id;
+    unsigned int generation;
+};
+
+template <typename T>
+class Handle
+{
+public:
+    Handle() : m_raw{INVALID_ID, 0} {}
+    explicit Handle(ActorHandle raw) : m_raw(raw) {}
+
+    ActorHandle raw() const { return m_raw; }
+    bool isNull() const { return m_raw.id == INVALID_ID; }
+
+private:
+    static const unsigned int INVALID_ID = ~0u;
+    ActorHandle m_raw;
+};
+
+// Structure-of-arrays storage for every actor in a world. Slot i of each array
+// belongs to the same actor; slots stay in creation order so passes that walk
+// them linearly visit actors in the same order the old actor vector did.
+class ActorStore
+{
+public:
+    // flag bits; per-type traits like collision filters live in ACTOR_TRAITS
+    static const unsigned char ALIVE = 1 << 0;
+    static const unsigned char PERSISTENT = 1 << 1; // never removed by removeDead
+
+    ActorStore();
+    ~ActorStore();
+
+    // returns the new actor's slot; the store owns the actor from here on
+    size_t add(Actor *owner, ActorType type, unsigned char flags, double x, double y, double horizSpeed, double vertSpeed, double radius);
+
+    // delete dead actors and compact the survivors, keeping their order
+    void removeDead();
+    // delete every actor
+    void clear();
+
+    size_t size() const { return m_owner.size(); }
+    ActorHandle handleOf(size_t slot) const { return ActorHandle{m_id[slot], m_generation[m_id[slot]]}; }
+    Actor *resolve(ActorHandle handle) const;
+
+    Actor *owner(size_t slot) const { return m_owner[slot]; }
+    ActorType type(size_t slot) const { return static_cast<ActorType>(m_type[slot]); }
+    bool hasFlags(size_t slot, unsigned char flags) const { return (m_flags[slot] & flags) == flags; }
+    void setFlag(size_t slot, unsigned char flag, bool value) { m_flags[slot] = value ? (m_flags[slot] | flag) : (m_flags[slot] & ~flag); }
+
+    double x(size_t slot) const { return m_x[slot]; }
+    double y(size_t slot) const { return m_y[slot]; }
+    double horizSpeed(size_t slot) const { return m_horizSpeed[slot]; }
+    double vertSpeed(size_t slot) const { return m_vertSpeed[slot]; }
+    double radius(size_t slot) const { return m_radius[slot]; }
+    int hp(size_t slot) const { return m_hp[slot]; }
+
+    void setPosition(size_t slot, double x, double y) { m_x[slot] = x; m_y[slot] = y; }
+    void setHorizSpeed(size_t slot, double speed) { m_horizSpeed[slot] = speed; }
+    void setVertSpeed(size_t slot, double speed) { m_vertSpeed[slot] = speed; }
+    void setHP(size_t slot, int hp) { m_hp[slot] = hp; }
+
+    // whole arrays, for passes that stream over every slot
+    double *xs() { return m_x.data(); }
+    double *ys() { return m_y.data(); }
+    const double *xs() const { return m_x.data(); }
+    const double *ys() const { return m_y.data(); }
+    const double *horizSpeeds() const { return m_horizSpeed.data(); }
+    const double *vertSpeeds() const { return m_vertSpeed.data(); }
+    const double *radii() const { return m_radius.data(); }
+    unsigned char *flags() { return m_flags.data(); }
+    const unsigned char *flags() const { return m_flags.data(); }
+    const unsigned char *types() const { return m_type.data(); }
+
+private:
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_horizSpeed;
+    std::vector<double> m_vertSpeed;
+    std::vector<double> m_radius;
+    std::vector<int> m_hp;
+    std::vector<unsigned char> m_flags;
+    std::vector<unsigned char> m_type;
+    std::vector<Actor *> m_owner;
+    std::vector<unsigned int> m_id;
+
+    // indexed by handle id
+    std::vector<size_t> m_slotOfId;
+    std::vector<unsigned int> m_generation;
+    std::vector<unsigned int> m_freeIds;
+
+    void moveSlot(size_t from, size_t to);
+
+    ActorStore(const ActorStore &);
+    ActorStore &operator=(const ActorStore &);
+};
+
+#endif // ACTORSTORE_H_
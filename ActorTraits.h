@@ -0,0 +1,84 @@
+#ifndef ACTORTRAITS_H_
+#define ACTORTRAITS_H_
+
+#include "ActorStore.h"
+
+// What every actor of a concrete type has in common, fixed at compile time.
+// Actors keep only their type tag; filters look traits up by type instead of
+// copying them into each instance.
+struct ActorTraits
+{
+    bool canCollideGR;
+    bool canCollideWater;
+    bool isCAW;          // collision-avoidance worthy: cabs keep their distance from it
+    bool scrolls;        // moved with the road by the movement kernel
+    bool exitScheduled;  // moves only with the road, so StudentWorld schedules the tick it leaves the screen
+    unsigned int depth;  // draw layer, 0 on top
+    double size;         // largest size, for types whose size varies per actor
+};
+
+// indexed by ActorType
+constexpr ActorTraits ACTOR_TRAITS[NUM_ACTOR_TYPES] = {
+    //  GR     water  CAW    scrolls exit   depth size
+    {false, false, true,  false, false, 0, 4.0}, // ACTOR_GHOST_RACER
+    {false, false, false, true,  true,  2, 2.0}, // ACTOR_BORDER_LINE
+    {true,  false, false, true,  true,  2, 5.0}, // ACTOR_OIL_SLICK, size varies from 2 to 5
+    {true,  false, false, true,  true,  2, 4.0}, // ACTOR_SOUL
+    {true,  true,  false, true,  true,  2, 1.0}, // ACTOR_HEAL_GOODIE
+    {true,  true,  false, true,  true,  2, 2.0}, // ACTOR_WATER_GOODIE
+    {true,  true,  true,  true,  false, 0, 2.0}, // ACTOR_HUMAN_PED
+    {true,  true,  true,  true,  false, 0, 3.0}, // ACTOR_ZOMBIE_PED
+    {true,  true,  true,  true,  false, 0, 4.0}, // ACTOR_ZOMBIE_CAB
+    {false, false, false, false, false, 1, 1.0}, // ACTOR_HOLY_WATER
+};
+
+constexpr const ActorTraits &actorTraits(ActorType type)
+{
+    return ACTOR_TRAITS[type];
+}
+
+// Bit t is set if ActorType t has @param trait, so a filter over a slot is
+// one shift of its type tag
+typedef unsigned int ActorTypeMask;
+
+constexpr ActorTypeMask typesWhere(bool ActorTraits::*trait)
+{
+    ActorTypeMask mask = 0;
+    for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+    {
+        if (ACTOR_TRAITS[type].*trait)
+        {
+            mask |= 1u << type;
+        }
+    }
+    return mask;
+}
+
+constexpr ActorTypeMask COLLIDES_GR_TYPES = typesWhere(&ActorTraits::canCollideGR);
+constexpr ActorTypeMask COLLIDES_WATER_TYPES = typesWhere(&ActorTraits::canCollideWater);
+constexpr ActorTypeMask CAW_TYPES = typesWhere(&ActorTraits::isCAW);
+constexpr ActorTypeMask SCROLLING_TYPES = typesWhere(&ActorTraits::scrolls);
+constexpr ActorTypeMask EXIT_SCHEDULED_TYPES = typesWhere(&ActorTraits::exitScheduled);
+
+constexpr bool isTypeIn(ActorTypeMask mask, unsigned char type)
+{
+    return (mask >> type) & 1;
+}
+
+// largest size among types in @param mask
+constexpr double maxSizeOf(ActorTypeMask mask)
+{
+    double size = 0;
+    for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+    {
+        if (isTypeIn(mask, type) && ACTOR_TRAITS[type].size > size)
+        {
+            size = ACTOR_TRAITS[type].size;
+        }
+    }
+    return size;
+}
+
+static_assert(NUM_ACTOR_TYPES <= 32, "ActorTypeMask needs a bit per actor type");
+
+#endif // ACTORTRAITS_H_
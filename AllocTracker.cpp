@@ -0,0 +1,193 @@
+#include "AllocTracker.h"
+
+#ifdef TRACK_ALLOCATIONS
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    const char *const PHASE_NAMES[NUM_ALLOC_PHASES] = {
+        "other", "update", "cleanup", "spawn", "cablanes", "scene", "stats", "sound"};
+
+    struct TickCounts
+    {
+        std::atomic<std::size_t> allocs[NUM_ALLOC_PHASES];
+        std::atomic<std::size_t> bytes[NUM_ALLOC_PHASES];
+    };
+
+    // each thread that runs ticks counts into its own TickCounts, so worlds on
+    // different threads report independently; pool workers running part of a
+    // tick count into that tick's thread's instead (see AllocContextScope)
+    thread_local TickCounts t_ownCounts;
+    thread_local TickCounts *t_counts = nullptr; // nullptr: t_ownCounts
+    thread_local AllocPhase t_phase = ALLOC_PHASE_OTHER;
+    thread_local unsigned long t_tick = 0;
+
+    TickCounts &counts()
+    {
+        return (t_counts != nullptr) ? *t_counts : t_ownCounts;
+    }
+
+    long readBudget()
+    {
+        const char *env = std::getenv("GHOSTRACER_ALLOC_BUDGET");
+        return (env == nullptr) ? -1 : std::strtol(env, nullptr, 10);
+    }
+
+    const long g_budget = readBudget();
+    // shared: worlds on different threads report ticks independently
+    std::atomic<unsigned long> g_overBudgetTicks(0);
+}
+
+bool AllocTracker::isBudgeted(AllocPhase phase)
+{
+    // creating actors is allowed to allocate, everything else in the loop is not
+    return phase != ALLOC_PHASE_SPAWN && phase != ALLOC_PHASE_SCENE;
+}
+
+AllocPhase AllocTracker::currentPhase()
+{
+    return t_phase;
+}
+
+void AllocTracker::setPhase(AllocPhase phase)
+{
+    t_phase = phase;
+}
+
+AllocTracker::Context AllocTracker::currentContext()
+{
+    return Context{&counts(), t_phase};
+}
+
+void AllocTracker::setContext(const Context &context)
+{
+    t_counts = static_cast<TickCounts *>(context.counts);
+    t_phase = context.phase;
+}
+
+/* Reset this thread's counters for a new tick */
+void AllocTracker::beginTick()
+{
+    // a whole world ticking inside a pool chunk (a sweep's games) counts for itself
+    t_counts = nullptr;
+    TickCounts &tick = t_ownCounts;
+    for (int i = 0; i < NUM_ALLOC_PHASES; ++i)
+    {
+        tick.allocs[i].store(0, std::memory_order_relaxed);
+        tick.bytes[i].store(0, std::memory_order_relaxed);
+    }
+    ++t_tick;
+}
+
+/* Print allocations and bytes for the tick, workers' included, and check it against the budget */
+void AllocTracker::endTick()
+{
+    // the tick's parallel work has all been joined by now
+    TickCounts &tick = counts();
+    std::size_t phaseAllocs[NUM_ALLOC_PHASES];
+    std::size_t phaseBytes[NUM_ALLOC_PHASES];
+    std::size_t allocs = 0;
+    std::size_t bytes = 0;
+    std::size_t budgetedAllocs = 0;
+    for (int i = 0; i < NUM_ALLOC_PHASES; ++i)
+    {
+        phaseAllocs[i] = tick.allocs[i].load(std::memory_order_relaxed);
+        phaseBytes[i] = tick.bytes[i].load(std::memory_order_relaxed);
+        allocs += phaseAllocs[i];
+        bytes += phaseBytes[i];
+        if (isBudgeted(static_cast<AllocPhase>(i)))
+        {
+            budgetedAllocs += phaseAllocs[i];
+        }
+    }
+
+    // fprintf so the report itself doesn't allocate
+    std::fprintf(stderr, "alloc tick %lu: %zu allocs %zu bytes", t_tick, allocs, bytes);
+    for (int i = 0; i < NUM_ALLOC_PHASES; ++i)
+    {
+        if (phaseAllocs[i] != 0)
+        {
+            std::fprintf(stderr, " %s=%zu/%zu", PHASE_NAMES[i], phaseAllocs[i], phaseBytes[i]);
+        }
+    }
+
+    if (g_budget >= 0 && budgetedAllocs > static_cast<std::size_t>(g_budget))
+    {
+        ++g_overBudgetTicks;
+        std::fprintf(stderr, " OVER BUDGET (%zu > %ld)", budgetedAllocs, g_budget);
+    }
+    std::fputc('\n', stderr);
+}
+
+long AllocTracker::budget()
+{
+    return g_budget;
+}
+
+bool AllocTracker::budgetExceeded()
+{
+    return g_overBudgetTicks != 0;
+}
+
+void AllocTracker::recordAlloc(std::size_t bytes)
+{
+    TickCounts &tick = counts();
+    tick.allocs[t_phase].fetch_add(1, std::memory_order_relaxed);
+    tick.bytes[t_phase].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// global replacements; every form funnels into these two
+
+void *operator new(std::size_t size)
+{
+    AllocTracker::recordAlloc(size);
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return ::operator new(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+void operator delete[](void *p) noexcept
+{
+    ::operator delete(p);
+}
+void operator delete(void *p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+void operator delete[](void *p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+#endif // TRACK_ALLOCATIONS
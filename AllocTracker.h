@@ -0,0 +1,128 @@
+#ifndef ALLOCTRACKER_H_
+#define ALLOCTRACKER_H_
+
+#include <cstddef>
+
+// Opt-in heap allocation accounting. Build with -DTRACK_ALLOCATIONS to replace
+// the global operator new/delete and get a per-tick report on stderr; without
+// the flag every hook below compiles away to nothing.
+
+// part of a tick that allocations are attributed to
+enum AllocPhase : int
+{
+    ALLOC_PHASE_OTHER,     // anything outside a tick (init, rendering, prompts)
+    ALLOC_PHASE_UPDATE,    // actors and GR doing something
+    ALLOC_PHASE_CLEANUP,   // removing dead actors
+    ALLOC_PHASE_SPAWN,     // spawners and actors creating actors
+    ALLOC_PHASE_CAB_LANES, // lane search in addZombieCab
+    ALLOC_PHASE_SCENE,     // GraphObject registry inserts
+    ALLOC_PHASE_STATS,     // status line formatting
+    ALLOC_PHASE_SOUND,     // playSound
+    NUM_ALLOC_PHASES
+};
+
+#ifdef TRACK_ALLOCATIONS
+
+class AllocTracker
+{
+public:
+    // phases that are expected to allocate and are left out of the budget
+    static bool isBudgeted(AllocPhase phase);
+
+    static AllocPhase currentPhase();
+    static void setPhase(AllocPhase phase);
+
+    // the tick and phase the calling thread's allocations count towards, so
+    // work it hands to other threads can be counted there too
+    struct Context
+    {
+        void *counts;
+        AllocPhase phase;
+    };
+    static Context currentContext();
+    static void setContext(const Context &context);
+
+    // called by StudentWorld around each tick; endTick prints the tick report
+    static void beginTick();
+    static void endTick();
+
+    // max budgeted allocations per tick, read from GHOSTRACER_ALLOC_BUDGET (-1 if unset)
+    static long budget();
+    static bool budgetExceeded();
+
+    // used by the operator new/delete replacements
+    static void recordAlloc(std::size_t bytes);
+};
+
+/* Attribute allocations in the enclosing scope to @param phase */
+class AllocPhaseScope
+{
+public:
+    explicit AllocPhaseScope(AllocPhase phase)
+        : m_prevPhase(AllocTracker::currentPhase())
+    {
+        AllocTracker::setPhase(phase);
+    }
+    ~AllocPhaseScope()
+    {
+        AllocTracker::setPhase(m_prevPhase);
+    }
+
+    AllocPhaseScope(const AllocPhaseScope &) = delete;
+    AllocPhaseScope &operator=(const AllocPhaseScope &) = delete;
+
+private:
+    AllocPhase m_prevPhase;
+};
+
+/* Count allocations in the enclosing scope towards @param context, taken on the thread that handed this work over */
+class AllocContextScope
+{
+public:
+    explicit AllocContextScope(const AllocTracker::Context &context)
+        : m_prevContext(AllocTracker::currentContext())
+    {
+        AllocTracker::setContext(context);
+    }
+    ~AllocContextScope()
+    {
+        AllocTracker::setContext(m_prevContext);
+    }
+
+    AllocContextScope(const AllocContextScope &) = delete;
+    AllocContextScope &operator=(const AllocContextScope &) = delete;
+
+private:
+    AllocTracker::Context m_prevContext;
+};
+
+#else
+
+class AllocTracker
+{
+public:
+    struct Context
+    {
+    };
+    static Context currentContext() { return Context(); }
+
+    static void beginTick() {}
+    static void endTick() {}
+    static bool budgetExceeded() { return false; }
+};
+
+class AllocPhaseScope
+{
+public:
+    explicit AllocPhaseScope(AllocPhase) {}
+};
+
+class AllocContextScope
+{
+public:
+    explicit AllocContextScope(const AllocTracker::Context &) {}
+};
+
+#endif // TRACK_ALLOCATIONS
+
+#endif // ALLOCTRACKER_H_
@@ -0,0 +1,387 @@
+#include "Autopilot.h"
+#include "StudentWorld.h"
+#include "Trig.h"
+#include <cmath>
+using namespace std;
+
+namespace
+{
+    const double HUMAN_COST = 1000;
+    // a path costing this much likely runs into something; below it, small
+    // goal and speed terms dominate and braking never wins
+    const double WORTH_BRAKING = 3;
+    // what the GR sprays to kill, and what it sprays to turn around
+    const ActorTypeMask ZOMBIE_TARGETS = (1u << ACTOR_ZOMBIE_PED) | (1u << ACTOR_ZOMBIE_CAB);
+    const ActorTypeMask HUMAN_PED_TARGETS = 1u << ACTOR_HUMAN_PED;
+
+    // how much an actor ahead of the GR makes a lane worth avoiding (negative)
+    // or steering for (positive), before weighting by how close it is
+    double laneValue(ActorType type, const GhostRacer *gr)
+    {
+        switch (type)
+        {
+        case ACTOR_HUMAN_PED:
+            return -8;
+        case ACTOR_ZOMBIE_CAB:
+            return -4;
+        case ACTOR_ZOMBIE_PED:
+            return -1;
+        case ACTOR_OIL_SLICK:
+            return -0.5;
+        case ACTOR_SOUL:
+            return 3;
+        case ACTOR_HEAL_GOODIE:
+            return (gr->getHP() < GhostRacer::INIT_HP * 3 / 4) ? 1 : 0;
+        case ACTOR_WATER_GOODIE:
+            return (gr->getSprayCount() < GhostRacer::INIT_WATER_COUNT) ? 1 : 0;
+        default:
+            return 0;
+        }
+    }
+
+    // what running into an actor costs the path that does it
+    double collisionCost(ActorType type)
+    {
+        switch (type)
+        {
+        case ACTOR_HUMAN_PED:
+            return HUMAN_COST; // ends the life
+        case ACTOR_ZOMBIE_CAB:
+            return 100;
+        case ACTOR_ZOMBIE_PED:
+            return 20;
+        case ACTOR_OIL_SLICK:
+            return 10;
+        default:
+            return 0;
+        }
+    }
+
+    // 1 for an actor level with the GR, falling off with distance
+    double closeness(double dy)
+    {
+        return 16 / (abs(dy) + 16);
+    }
+
+    const int TURN_STEP = static_cast<int>(GhostRacer::TURN_ANGLE_INCREMENT);
+
+    // extra clearance around a predicted collision box, for the prediction's error
+    const double MARGIN = 4;
+    // how much wider, per tick ahead, a pedestrian's predicted box gets
+    const double PED_DRIFT = 0.5;
+}
+
+GameServices *createAutopilot(GameWorld *world, GameServices *host)
+{
+    return new Autopilot(*static_cast<StudentWorld *>(world), host);
+}
+
+Autopilot::Autopilot(StudentWorld &world, GameServices *host)
+    : m_world(world), m_host(host)
+{
+}
+
+/*
+ * Follow the cheapest plan: turn first, since a late correction is what gets
+ * the GR killed; then spray if the plan has nothing else to do this tick;
+ * then change speed.
+ */
+int Autopilot::chooseKey()
+{
+    const GhostRacer *gr = m_world.getGR();
+    if (gr == nullptr || !gr->isAlive())
+    {
+        return 0;
+    }
+
+    double cost;
+    Plan plan = bestPlan(cost);
+    // when every plan runs into a human, turning it around is the last resort
+    if (cost >= HUMAN_COST / 2 && gr->getSprayCount() > 0 && hasTargetInLineOfFire(HUMAN_PED_TARGETS))
+    {
+        return KEY_PRESS_SPACE;
+    }
+    if (gr->getDirection() < plan.direction)
+    {
+        return KEY_PRESS_LEFT;
+    }
+    if (gr->getDirection() > plan.direction)
+    {
+        return KEY_PRESS_RIGHT;
+    }
+
+    if (gr->getSprayCount() > 0 && hasTargetInLineOfFire(ZOMBIE_TARGETS))
+    {
+        return KEY_PRESS_SPACE;
+    }
+
+    if (gr->getVertSpeed() < plan.speed)
+    {
+        return KEY_PRESS_UP;
+    }
+    if (gr->getVertSpeed() > plan.speed)
+    {
+        return KEY_PRESS_DOWN;
+    }
+    return 0;
+}
+
+/* The plan whose path over the next HORIZON ticks costs least; @param cost is set to what it costs */
+Autopilot::Plan Autopilot::bestPlan(double &cost)
+{
+    gatherObstacles();
+    double goalX = targetX();
+
+    // braking hard lets what's ahead pass before the GR gets there, but is only
+    // worth weighing when every cruising path runs into something
+    int current = m_world.getGR()->getDirection();
+    Plan best = {current, CRUISE_SPEED};
+    double bestCost = pathCost(best, goalX);
+    considerTurns(CRUISE_SPEED, goalX, best, bestCost);
+    if (bestCost >= WORTH_BRAKING)
+    {
+        considerPlan(Plan{current, GhostRacer::MIN_VERT_SPEED}, goalX, best, bestCost);
+        considerTurns(GhostRacer::MIN_VERT_SPEED, goalX, best, bestCost);
+    }
+    cost = bestCost;
+    return best;
+}
+
+/* Weigh turning to every direction the GR can reach exactly, a whole number of turns away, then going at @param speed */
+void Autopilot::considerTurns(double speed, double goalX, Plan &best, double &bestCost) const
+{
+    int current = m_world.getGR()->getDirection();
+    for (int left = current; left < GhostRacer::LEFT_ANGLE_TURN_LIMIT;)
+    {
+        left += TURN_STEP;
+        considerPlan(Plan{left, speed}, goalX, best, bestCost);
+    }
+    for (int right = current; right > GhostRacer::RIGHT_ANGLE_TURN_LIMIT;)
+    {
+        right -= TURN_STEP;
+        considerPlan(Plan{right, speed}, goalX, best, bestCost);
+    }
+}
+
+/* Make @param plan the @param best so far if its path is cheaper */
+void Autopilot::considerPlan(Plan plan, double goalX, Plan &best, double &bestCost) const
+{
+    double cost = pathCost(plan, goalX);
+    if (cost < bestCost)
+    {
+        best = plan;
+        bestCost = cost;
+    }
+}
+
+/*
+ * Cost of following @param plan, one key a tick: every obstacle the GR would
+ * run into, leaving the road, dawdling below cruising speed, and how far the
+ * path ends up from @param goalX.
+ */
+double Autopilot::pathCost(Plan plan, double goalX) const
+{
+    const GhostRacer *gr = m_world.getGR();
+    // the GR's path first, then every obstacle against all of it in one tight loop
+    double pathX[HORIZON];
+    double climb[HORIZON]; // how far the GR has moved up the road, relative to where it started
+    double x = gr->getX();
+    int heading = gr->getDirection();
+    double speed = gr->getVertSpeed();
+    double travelled = 0;
+    double cost = 0;
+    for (int k = 0; k < HORIZON; ++k)
+    {
+        if (heading < plan.direction)
+            heading += TURN_STEP;
+        else if (heading > plan.direction)
+            heading -= TURN_STEP;
+        else if (speed < plan.speed)
+            speed += GhostRacer::SPEED_INCREMENT;
+        else if (speed > plan.speed)
+            speed -= GhostRacer::SPEED_INCREMENT;
+        // as GhostRacer::move computes it
+        x += cosDegrees(heading) * GhostRacer::MAX_SHIFT_PER_TICK;
+        travelled += speed;
+        pathX[k] = x;
+        climb[k] = travelled;
+
+        if (x <= StudentWorld::ROAD_LEFT_EDGE || x >= StudentWorld::ROAD_RIGHT_EDGE)
+        {
+            cost += 50;
+        }
+        cost += (CRUISE_SPEED - speed) * 0.05;
+    }
+
+    for (const Obstacle &obstacle : m_obstacles)
+    {
+        double hits = 0;
+        for (int k = 0; k < HORIZON; ++k)
+        {
+            // pedestrians pick new plans without warning, so where they'll be gets vaguer with time
+            double t = k + 1;
+            double dx = obstacle.x + obstacle.horizSpeed * t - pathX[k];
+            double dy = obstacle.dy + obstacle.vertSpeed * t - climb[k];
+            bool hit = (abs(dx) < obstacle.halfWidth + obstacle.drift * t) & (abs(dy) < obstacle.halfHeight);
+            // sooner hits leave less room to correct later
+            hits += hit ? (HORIZON - k) : 0;
+        }
+        cost += obstacle.cost * hits / HORIZON;
+    }
+    return cost + abs(x - goalX) * 0.05;
+}
+
+/* Keep the actors the GR could run into within HORIZON ticks */
+void Autopilot::gatherObstacles()
+{
+    const GhostRacer *gr = m_world.getGR();
+    const ActorStore &store = m_world.store();
+    const double *xs = store.xs();
+    const double *ys = store.ys();
+    const double *horizSpeeds = store.horizSpeeds();
+    const double *vertSpeeds = store.vertSpeeds();
+    const double *radii = store.radii();
+    const unsigned char *types = store.types();
+    const unsigned char *flags = store.flags();
+    double grY = gr->getY();
+    double grRadius = gr->getRadius();
+
+    m_obstacles.clear();
+    for (size_t i = StudentWorld::GR_SLOT + 1; i < store.size(); ++i)
+    {
+        ActorType type = static_cast<ActorType>(types[i]);
+        double cost = collisionCost(type);
+        double dy = ys[i] - grY;
+        if (cost == 0 || !(flags[i] & ActorStore::ALIVE) || dy < -LOOK_BEHIND || dy > LOOK_AHEAD)
+        {
+            continue;
+        }
+        double reach = grRadius + radii[i];
+        double drift = (type == ACTOR_HUMAN_PED || type == ACTOR_ZOMBIE_PED) ? PED_DRIFT : 0;
+        m_obstacles.push_back(Obstacle{xs[i], dy, horizSpeeds[i], vertSpeeds[i],
+                                       reach * Actor::X_SCALE + MARGIN, reach * Actor::Y_SCALE + MARGIN, drift, cost});
+    }
+}
+
+/* Centre of the lane with the best value ahead, or the soul to collect in it */
+double Autopilot::targetX() const
+{
+    const GhostRacer *gr = m_world.getGR();
+    const ActorStore &store = m_world.store();
+    const double *xs = store.xs();
+    const double *ys = store.ys();
+    const unsigned char *types = store.types();
+    const unsigned char *flags = store.flags();
+    double grY = gr->getY();
+    int currentLane = ROAD.laneAt(gr->getX());
+
+    // an actor counts towards every lane its centre is within most of a lane width of
+    double value[StudentWorld::NUM_LANES] = {};
+    double soulX[StudentWorld::NUM_LANES];
+    double soulDy[StudentWorld::NUM_LANES];
+    for (int lane = 0; lane < StudentWorld::NUM_LANES; ++lane)
+    {
+        soulX[lane] = ROAD.center(lane);
+        soulDy[lane] = LOOK_AHEAD;
+    }
+    for (size_t i = StudentWorld::GR_SLOT + 1; i < store.size(); ++i)
+    {
+        double dy = ys[i] - grY;
+        if (!(flags[i] & ActorStore::ALIVE) || dy < -LOOK_BEHIND || dy > LOOK_AHEAD)
+        {
+            continue;
+        }
+        ActorType type = static_cast<ActorType>(types[i]);
+        double weight = laneValue(type, gr) * closeness(dy);
+        if (weight == 0)
+        {
+            continue;
+        }
+        for (int lane = 0; lane < StudentWorld::NUM_LANES; ++lane)
+        {
+            double spread = 1 - abs(xs[i] - ROAD.center(lane)) / (ROAD.laneWidth() * 0.75);
+            value[lane] += weight * max(0.0, spread);
+        }
+        int lane = ROAD.laneAt(xs[i]);
+        if (type == ACTOR_SOUL && lane >= 0 && dy >= 0 && dy < soulDy[lane])
+        {
+            soulX[lane] = xs[i];
+            soulDy[lane] = dy;
+        }
+    }
+
+    // a small bias for staying put keeps the GR from weaving between equal lanes
+    int best = 0;
+    for (int lane = 0; lane < StudentWorld::NUM_LANES; ++lane)
+    {
+        value[lane] -= 0.1 * abs(lane - (currentLane < 0 ? lane : currentLane));
+        if (value[lane] > value[best])
+        {
+            best = lane;
+        }
+    }
+    return soulX[best];
+}
+
+/* Whether holy water sprayed now would run into an actor of a type in @param targets ahead */
+bool Autopilot::hasTargetInLineOfFire(ActorTypeMask targets) const
+{
+    const GhostRacer *gr = m_world.getGR();
+    const ActorStore &store = m_world.store();
+    const double *xs = store.xs();
+    const double *ys = store.ys();
+    const double *radii = store.radii();
+    const unsigned char *types = store.types();
+    const unsigned char *flags = store.flags();
+    double grX = gr->getX();
+    double grY = gr->getY();
+    double slope = cosDegrees(gr->getDirection()) / sinDegrees(gr->getDirection());
+
+    for (size_t i = StudentWorld::GR_SLOT + 1; i < store.size(); ++i)
+    {
+        ActorType type = static_cast<ActorType>(types[i]);
+        double dy = ys[i] - grY;
+        if (!(flags[i] & ActorStore::ALIVE) || !isTypeIn(targets, type) ||
+            dy <= 0 || dy > ProjectileRing::MAX_TRAVEL_DIST)
+        {
+            continue;
+        }
+        // where the spray's path crosses the actor's row, against its collision box
+        double pathX = grX + dy * slope;
+        if (abs(xs[i] - pathX) < radii[i] * Actor::X_SCALE * 2)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Autopilot::getLastKey(int &value)
+{
+    value = chooseKey();
+    return value != 0;
+}
+
+void Autopilot::playSound(int soundID)
+{
+    if (m_host != nullptr)
+        m_host->playSound(soundID);
+}
+
+void Autopilot::setGameStatText(string_view text)
+{
+    if (m_host != nullptr)
+        m_host->setGameStatText(text);
+}
+
+void Autopilot::setMsPerTick(int ms_per_tick)
+{
+    if (m_host != nullptr)
+        m_host->setMsPerTick(ms_per_tick);
+}
+
+void Autopilot::quitGame()
+{
+    if (m_host != nullptr)
+        m_host->quitGame();
+}
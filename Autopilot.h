@@ -0,0 +1,76 @@
+#ifndef AUTOPILOT_H_
+#define AUTOPILOT_H_
+
+#include "GameServices.h"
+#include "ActorTraits.h"
+#include <vector>
+
+class GameWorld;
+class StudentWorld;
+
+// A scripted driver for soak tests and benchmarks. It answers GhostRacer's
+// key poll each tick with the key that best keeps it alive and scoring:
+// steer along the path that misses the cabs and humans closing in and heads
+// for the lane with the most souls, spray zombies and cabs in the line of
+// fire, and hold a cruising speed. Everything but keys (sounds, status text,
+// quitting) goes to @param host if there is one, so it can drive the
+// windowed game too.
+class Autopilot : public GameServices
+{
+public:
+    // how far ahead of and behind the GR actors are considered
+    static constexpr double LOOK_AHEAD = 160;
+    static constexpr double LOOK_BEHIND = 48;
+    // ticks of each candidate path checked for collisions
+    static const int HORIZON = 24;
+    static constexpr double CRUISE_SPEED = 4;
+
+    explicit Autopilot(StudentWorld &world, GameServices *host = nullptr);
+
+    // the key to press this tick, or 0 for none
+    int chooseKey();
+
+    bool getLastKey(int &value) override;
+    void playSound(int soundID) override;
+    void setGameStatText(std::string_view text) override;
+    void setMsPerTick(int ms_per_tick) override;
+    void quitGame() override;
+
+private:
+    // an actor near the GR's path, relative to the GR and predicted linearly
+    struct Obstacle
+    {
+        double x;
+        double dy;
+        double horizSpeed;
+        double vertSpeed;
+        double halfWidth;    // of the box that would overlap the GR
+        double halfHeight;
+        double drift;        // how fast the prediction's sideways error grows
+        double cost;         // of running into it
+    };
+
+    // what to steer for: a direction to turn to, then a speed to reach
+    struct Plan
+    {
+        int direction;
+        double speed;
+    };
+
+    StudentWorld &m_world;
+    GameServices *m_host;
+    std::vector<Obstacle> m_obstacles; // scratch, reused every tick
+
+    double targetX() const;
+    void gatherObstacles();
+    Plan bestPlan(double &cost);
+    void considerTurns(double speed, double goalX, Plan &best, double &bestCost) const;
+    void considerPlan(Plan plan, double goalX, Plan &best, double &bestCost) const;
+    double pathCost(Plan plan, double goalX) const;
+    bool hasTargetInLineOfFire(ActorTypeMask targets) const;
+};
+
+// an Autopilot for @param world, which must be a StudentWorld, for callers that only see GameWorld
+GameServices *createAutopilot(GameWorld *world, GameServices *host);
+
+#endif // AUTOPILOT_H_
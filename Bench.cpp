@@ -0,0 +1,549 @@
+#include "Bench.h"
+#include "ActorStore.h"
+#include "Autopilot.h"
+#include "GameConstants.h"
+#include "MovementKernel.h"
+#include "OccupancyGrid.h"
+#include "Road.h"
+#include "StudentWorld.h"
+#include "Trig.h"
+#include "VecEnv.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+using namespace std;
+
+namespace
+{
+    typedef chrono::steady_clock Clock;
+
+    double elapsedNs(Clock::time_point start)
+    {
+        return chrono::duration<double, nano>(Clock::now() - start).count();
+    }
+
+    /*
+     * Time each movement kernel variant over @param count synthetic actors.
+     * Every other tick runs with negated speeds so actors drift back and forth
+     * instead of leaving the screen, keeping the live set the same size.
+     */
+    int benchMovement(int argc, char *argv[])
+    {
+        size_t count = (argc > 0) ? strtoul(argv[0], nullptr, 10) : 10000;
+        int ticks = (argc > 1) ? atoi(argv[1]) : 2000;
+        if (count == 0 || ticks <= 0)
+        {
+            fprintf(stderr, "usage: -bench movement [actors] [ticks]\n");
+            return 1;
+        }
+
+        // one in eight slots isn't scrolled, like the GR, to keep the kernels' skip path honest
+        default_random_engine rng(1);
+        uniform_real_distribution<double> xDist(VIEW_WIDTH / 4, VIEW_WIDTH * 3 / 4);
+        uniform_real_distribution<double> yDist(VIEW_HEIGHT / 4, VIEW_HEIGHT * 3 / 4);
+        uniform_int_distribution<int> speedDist(-4, 4);
+        vector<double> startX(count), startY(count);
+        vector<double> horizSpeed(count), vertSpeed(count), backHorizSpeed(count), backVertSpeed(count);
+        vector<unsigned char> types(count), startFlags(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            startX[i] = xDist(rng);
+            startY[i] = yDist(rng);
+            horizSpeed[i] = speedDist(rng);
+            vertSpeed[i] = speedDist(rng);
+            backHorizSpeed[i] = -horizSpeed[i];
+            backVertSpeed[i] = -vertSpeed[i];
+            types[i] = (i % 8 == 0) ? ACTOR_GHOST_RACER : ACTOR_ZOMBIE_PED;
+            startFlags[i] = ActorStore::ALIVE;
+        }
+        const double grVertSpeed = 2;
+
+        printf("movement: %zu actors, %d ticks, runtime pick %s\n", count, ticks, movementKernelName(bestMovementKernel()));
+        for (int k = 0; k < NUM_MOVEMENT_KERNELS; ++k)
+        {
+            MovementKernel kernel = static_cast<MovementKernel>(k);
+            if (!isMovementKernelSupported(kernel))
+            {
+                printf("  %-7s unsupported\n", movementKernelName(kernel));
+                continue;
+            }
+
+            vector<double> x = startX, y = startY;
+            vector<unsigned char> flags = startFlags;
+            // one untimed pass to fault in pages and warm caches
+            advanceScrollingWith(kernel, x.data(), y.data(), horizSpeed.data(), vertSpeed.data(), types.data(), flags.data(), 0, count, grVertSpeed);
+            advanceScrollingWith(kernel, x.data(), y.data(), backHorizSpeed.data(), backVertSpeed.data(), types.data(), flags.data(), 0, count, -grVertSpeed);
+
+            Clock::time_point start = Clock::now();
+            for (int t = 0; t < ticks; ++t)
+            {
+                if (t % 2 == 0)
+                    advanceScrollingWith(kernel, x.data(), y.data(), horizSpeed.data(), vertSpeed.data(), types.data(), flags.data(), 0, count, grVertSpeed);
+                else
+                    advanceScrollingWith(kernel, x.data(), y.data(), backHorizSpeed.data(), backVertSpeed.data(), types.data(), flags.data(), 0, count, -grVertSpeed);
+            }
+            double ns = elapsedNs(start);
+
+            size_t alive = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                alive += (flags[i] & ActorStore::ALIVE) ? 1 : 0;
+            }
+            printf("  %-7s %8.3f actors/ns  %8.1f ns/tick  (%zu alive)\n", movementKernelName(kernel),
+                   count * static_cast<double>(ticks) / ns, ns / ticks, alive);
+        }
+        return 0;
+    }
+
+    // the old way: test each lane's bounds in turn, as ZombieCab::getLane's if-chain did
+    template <int Lanes>
+    int laneByScan(const RoadLayout<Lanes> &road, double x)
+    {
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            if (x >= road.edge(lane) && x < road.edge(lane + 1))
+            {
+                return lane;
+            }
+        }
+        return -1;
+    }
+
+    /* Time both lane lookups over @param xs on a road of Lanes lanes, and check they agree */
+    template <int Lanes>
+    bool benchLanesOf(const vector<double> &unitXs, int rounds)
+    {
+        const RoadLayout<Lanes> road(ROAD_CENTER, ROAD_WIDTH / 3);
+        // spread the samples over the road plus a lane's width of shoulder on each side
+        vector<double> xs(unitXs.size());
+        for (size_t i = 0; i < xs.size(); ++i)
+        {
+            xs[i] = road.leftEdge() - road.laneWidth() + unitXs[i] * (Lanes + 2) * road.laneWidth();
+        }
+
+        long sums[2] = {0, 0};
+        double ns[2];
+        for (int method = 0; method < 2; ++method)
+        {
+            Clock::time_point start = Clock::now();
+            for (int r = 0; r < rounds; ++r)
+            {
+                for (double x : xs)
+                {
+                    sums[method] += (method == 0) ? road.laneAt(x) : laneByScan(road, x);
+                }
+            }
+            ns[method] = elapsedNs(start);
+        }
+
+        double lookups = static_cast<double>(xs.size()) * rounds;
+        printf("  %4d lanes  table %6.2f ns/lookup  scan %6.2f ns/lookup\n", Lanes, ns[0] / lookups, ns[1] / lookups);
+        return sums[0] == sums[1];
+    }
+
+    /* Lane classification cost against road width, table lookup vs a scan of the lanes */
+    int benchLanes(int argc, char *argv[])
+    {
+        size_t count = (argc > 0) ? strtoul(argv[0], nullptr, 10) : 100000;
+        int rounds = (argc > 1) ? atoi(argv[1]) : 100;
+        if (count == 0 || rounds <= 0)
+        {
+            fprintf(stderr, "usage: -bench lanes [positions] [rounds]\n");
+            return 1;
+        }
+
+        default_random_engine rng(1);
+        uniform_real_distribution<double> unitDist(0, 1);
+        vector<double> unitXs(count);
+        for (double &x : unitXs)
+        {
+            x = unitDist(rng);
+        }
+
+        printf("lanes: %zu positions, %d rounds\n", count, rounds);
+        bool agree = benchLanesOf<3>(unitXs, rounds) && benchLanesOf<8>(unitXs, rounds) &&
+                     benchLanesOf<32>(unitXs, rounds) && benchLanesOf<128>(unitXs, rounds);
+        if (!agree)
+        {
+            fprintf(stderr, "lane lookups disagree\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    /* World ticks per second through VecEnv with random actions, over @param worlds headless worlds */
+    int benchEnv(int argc, char *argv[])
+    {
+        size_t worlds = (argc > 0) ? strtoul(argv[0], nullptr, 10) : 64;
+        int steps = (argc > 1) ? atoi(argv[1]) : 2000;
+        unsigned int threads = (argc > 2) ? atoi(argv[2]) : 0;
+        if (worlds == 0 || steps <= 0)
+        {
+            fprintf(stderr, "usage: -bench env [worlds] [steps] [threads]\n");
+            return 1;
+        }
+
+        VecEnv env(worlds, 1, threads);
+        vector<float> observations(worlds * VecEnv::OBSERVATION_SIZE);
+        vector<float> rewards(worlds);
+        vector<unsigned char> done(worlds);
+        // a fixed random action script, drawn up front so the timed loop only steps
+        const int SCRIPT_STEPS = 1024;
+        default_random_engine rng(1);
+        uniform_int_distribution<int> actionDist(0, NUM_ENV_ACTIONS - 1);
+        vector<int> actions(SCRIPT_STEPS * worlds);
+        for (int &action : actions)
+        {
+            action = actionDist(rng);
+        }
+
+        env.reset(observations.data());
+        double totalReward = 0;
+        size_t episodes = 0;
+        Clock::time_point start = Clock::now();
+        for (int t = 0; t < steps; ++t)
+        {
+            env.step(actions.data() + (t % SCRIPT_STEPS) * worlds, observations.data(), rewards.data(), done.data());
+            for (size_t i = 0; i < worlds; ++i)
+            {
+                totalReward += rewards[i];
+                episodes += done[i];
+            }
+        }
+        double ns = elapsedNs(start);
+
+        printf("env: %zu worlds, %d steps\n", worlds, steps);
+        printf("  %.0f world ticks/s  %.1f us/step  %zu lives or levels ended  %.0f total reward\n",
+               worlds * static_cast<double>(steps) * 1e9 / ns, ns / steps / 1000, episodes, totalReward);
+        return 0;
+    }
+
+    /* Occupancy grid cost against the tick it describes, over a seeded headless game with @param crowd extra zombies */
+    int benchGrid(int argc, char *argv[])
+    {
+        int ticks = (argc > 0) ? atoi(argv[0]) : 5000;
+        int crowd = (argc > 1) ? atoi(argv[1]) : 0;
+        if (ticks <= 0 || crowd < 0)
+        {
+            fprintf(stderr, "usage: -bench grid [ticks] [crowd]\n");
+            return 1;
+        }
+
+        StudentWorld world("");
+        world.setSeed(1);
+        world.setWorkerThreads(1);
+        vector<unsigned char> grid(GRID_CELLS);
+        double tickNs = 0, gridNs = 0;
+        size_t actors = 0, covered = 0;
+        for (int t = 0; t < ticks; ++t)
+        {
+            if (world.getGR() == nullptr)
+            {
+                world.restartGame();
+                world.init();
+                for (int k = 0; k < crowd; ++k)
+                {
+                    world.spawn<ZombiePedestrian>(double(world.randInt(0, VIEW_WIDTH)), double(world.randInt(0, VIEW_HEIGHT)));
+                }
+            }
+
+            Clock::time_point start = Clock::now();
+            int status = world.move();
+            tickNs += elapsedNs(start);
+            start = Clock::now();
+            rasterizeOccupancy(world.store(), world.projectiles(), grid.data());
+            gridNs += elapsedNs(start);
+
+            actors += world.store().size();
+            for (unsigned char cell : grid)
+            {
+                covered += cell;
+            }
+            if (status != GWSTATUS_CONTINUE_GAME)
+            {
+                world.cleanUp();
+            }
+        }
+
+        printf("grid: %d ticks, %.0f actors on average, %.1f%% of cells covered\n", ticks,
+               actors / static_cast<double>(ticks), 100.0 * covered / (static_cast<double>(ticks) * GRID_CELLS));
+        printf("  tick %8.0f ns  grid %8.0f ns\n", tickNs / ticks, gridNs / ticks);
+        return 0;
+    }
+
+    /* Seeded headless games driven by the autopilot: how long they last, how far they get and what a tick costs */
+    int benchAutopilot(int argc, char *argv[])
+    {
+        int games = (argc > 0) ? atoi(argv[0]) : 8;
+        int maxTicks = (argc > 1) ? atoi(argv[1]) : 50000;
+        if (games <= 0 || maxTicks <= 0)
+        {
+            fprintf(stderr, "usage: -bench autopilot [games] [max ticks]\n");
+            return 1;
+        }
+
+        printf("autopilot: %d games of at most %d ticks\n", games, maxTicks);
+        for (int g = 0; g < games; ++g)
+        {
+            StudentWorld world("");
+            world.setSeed(g + 1);
+            world.setWorkerThreads(1);
+            Autopilot pilot(world);
+            world.setServices(&pilot);
+            world.init();
+
+            size_t peakActors = 0;
+            int tick = 0;
+            Clock::time_point start = Clock::now();
+            while (tick < maxTicks)
+            {
+                int status = world.move();
+                ++tick;
+                peakActors = max(peakActors, world.store().size());
+                if (status == GWSTATUS_PLAYER_DIED && world.isGameOver())
+                {
+                    break;
+                }
+                if (status == GWSTATUS_FINISHED_LEVEL)
+                {
+                    world.advanceToNextLevel();
+                }
+                if (status != GWSTATUS_CONTINUE_GAME)
+                {
+                    world.cleanUp();
+                    world.init();
+                }
+            }
+            double ns = elapsedNs(start);
+            printf("  seed %3d  %6d ticks  level %2d  score %6d  peak %5zu actors  %7.0f ns/tick\n",
+                   g + 1, tick, world.getLevel(), world.getScore(), peakActors, ns / tick);
+        }
+        return 0;
+    }
+
+    /*
+     * A horde-mode world left to run with nobody driving: the zombie count and
+     * tick cost as the crowd builds up, against a 60 Hz frame's budget.
+     */
+    int benchHorde(int argc, char *argv[])
+    {
+        int ticks = (argc > 0) ? atoi(argv[0]) : 300;
+        int threads = (argc > 1) ? atoi(argv[1]) : 1;
+        if (ticks <= 0 || threads <= 0)
+        {
+            fprintf(stderr, "usage: -bench horde [ticks] [threads]\n");
+            return 1;
+        }
+        const double FRAME_NS = 1e9 / 60;
+        const int REPORTS = 10;
+        const ActorTypeMask ZOMBIE_TYPES = (1u << ACTOR_ZOMBIE_PED) | (1u << ACTOR_ZOMBIE_CAB);
+
+        StudentWorld world("");
+        world.setSeed(1);
+        world.setWorkerThreads(threads);
+        world.setHordeMode(true);
+        world.init();
+
+        printf("horde: %d ticks on %d threads\n", ticks, threads);
+        int reportEvery = max(1, ticks / REPORTS);
+        double windowNs = 0, worstNs = 0;
+        for (int t = 1; t <= ticks; ++t)
+        {
+            Clock::time_point start = Clock::now();
+            int status = world.move();
+            double ns = elapsedNs(start);
+            windowNs += ns;
+            worstNs = max(worstNs, ns);
+            if (status != GWSTATUS_CONTINUE_GAME)
+            {
+                world.cleanUp();
+                world.init();
+            }
+
+            if (t % reportEvery == 0)
+            {
+                const ActorStore &store = world.store();
+                size_t zombies = 0;
+                for (size_t i = 0; i < store.size(); ++i)
+                {
+                    zombies += isTypeIn(ZOMBIE_TYPES, store.type(i));
+                }
+                double meanNs = windowNs / reportEvery;
+                printf("  tick %6d  %6zu zombies  %6zu actors  %8.3f ms/tick (%5.1f%% of 60 Hz)  worst %8.3f ms\n",
+                       t, zombies, store.size(), meanNs / 1e6, 100 * meanNs / FRAME_NS, worstNs / 1e6);
+                windowNs = 0;
+                worstNs = 0;
+            }
+        }
+        return 0;
+    }
+
+    /*
+     * Tick cost with and without swarm steering as the zombie count doubles,
+     * with a dozen cabs, about a normal game's, to dodge. With the spatial index a
+     * zombie's nearest neighbours are found without reading the whole crowd
+     * around it, so the per-zombie column should grow far slower than the
+     * count. Zombies start well above the GR and
+     * runs are short enough that none reach it or leave the screen; each is
+     * the best of a few, to keep scheduling noise out.
+     */
+    int benchSwarm(int argc, char *argv[])
+    {
+        int maxZombies = (argc > 0) ? atoi(argv[0]) : 16000;
+        int ticks = (argc > 1) ? atoi(argv[1]) : 12;
+        if (maxZombies <= 0 || ticks <= 0 || ticks > 20)
+        {
+            fprintf(stderr, "usage: -bench swarm [max zombies] [ticks, at most 20]\n");
+            return 1;
+        }
+        const int REPEATS = 3;
+        const int SWARM_CABS = 12;
+
+        printf("swarm: %d ticks per run\n", ticks);
+        printf("  %7s  %12s  %12s  %15s\n", "zombies", "off ns/tick", "on ns/tick", "steer ns/zombie");
+        for (int zombies = 500; zombies <= maxZombies; zombies *= 2)
+        {
+            double ns[2] = {0, 0};
+            for (int run = 0; run < 2 * REPEATS; ++run)
+            {
+                int swarm = run % 2;
+                StudentWorld world("");
+                world.setSeed(1);
+                world.setWorkerThreads(1);
+                world.setSwarmSteering(swarm == 1);
+                world.init();
+                for (int k = 0; k < zombies; ++k)
+                {
+                    world.spawn<ZombiePedestrian>(double(world.randInt(0, VIEW_WIDTH)), double(world.randInt(VIEW_HEIGHT / 2, VIEW_HEIGHT)));
+                }
+                for (int k = 0; k < SWARM_CABS; ++k)
+                {
+                    int lane = world.randInt(0, StudentWorld::NUM_LANES - 1);
+                    world.spawn<ZombieCab>(0.0, ROAD.center(lane), double(world.randInt(VIEW_HEIGHT / 2, VIEW_HEIGHT)));
+                }
+                world.move(); // untimed, to warm caches
+                Clock::time_point start = Clock::now();
+                for (int t = 0; t < ticks; ++t)
+                {
+                    world.move();
+                }
+                double runNs = elapsedNs(start) / ticks;
+                ns[swarm] = (run < 2) ? runNs : min(ns[swarm], runNs);
+            }
+            printf("  %7d  %12.0f  %12.0f  %15.1f\n", zombies, ns[0], ns[1], (ns[1] - ns[0]) / zombies);
+        }
+        return 0;
+    }
+
+    /*
+     * Holy water hit tests over @param targets zombies: the point test at the
+     * projectile's position, scanning every slot as findProjectileHit does,
+     * against the swept test along the path since its last check on the
+     * broadphase. Zombies fall at their own speed with the GR stopped, so the
+     * swept test also catches ones that a projectile passed through.
+     */
+    int benchProjectile(int argc, char *argv[])
+    {
+        int targets = (argc > 0) ? atoi(argv[0]) : 4000;
+        int projectiles = (argc > 1) ? atoi(argv[1]) : 256;
+        if (targets <= 0 || projectiles <= 0)
+        {
+            fprintf(stderr, "usage: -bench projectile [targets] [projectiles]\n");
+            return 1;
+        }
+        const int ROUNDS = 20;
+
+        StudentWorld world("");
+        world.setSeed(1);
+        world.init();
+        for (int k = 0; k < targets; ++k)
+        {
+            world.spawn<ZombiePedestrian>(double(world.randInt(0, VIEW_WIDTH)), double(world.randInt(0, VIEW_HEIGHT)));
+        }
+        struct Shot
+        {
+            double x, y;
+            double fromX, fromY;
+        };
+        vector<Shot> shots;
+        for (int k = 0; k < projectiles; ++k)
+        {
+            int direction = world.randInt(0, 359);
+            double x = world.randInt(0, VIEW_WIDTH);
+            double y = world.randInt(0, VIEW_HEIGHT);
+            shots.push_back(Shot{x, y, x - ProjectileRing::SPEED * cosDegrees(direction), y - ProjectileRing::SPEED * sinDegrees(direction)});
+        }
+
+        Clock::time_point start = Clock::now();
+        world.indexProjectileTargets();
+        double indexNs = elapsedNs(start);
+
+        size_t pointHits = 0, sweptHits = 0;
+        start = Clock::now();
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            for (const Shot &shot : shots)
+            {
+                pointHits += world.findProjectileHit(shot.x, shot.y, 0, world.store().size()) != StudentWorld::NO_SLOT;
+            }
+        }
+        double pointNs = elapsedNs(start) / (ROUNDS * shots.size());
+        start = Clock::now();
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            for (const Shot &shot : shots)
+            {
+                sweptHits += world.findSweptProjectileHit(shot.fromX, shot.fromY, shot.x, shot.y) != StudentWorld::NO_SLOT;
+            }
+        }
+        double sweptNs = elapsedNs(start) / (ROUNDS * shots.size());
+
+        printf("projectile: %d targets, %d projectiles\n", targets, projectiles);
+        printf("  point test, linear scan  %10.0f ns/projectile  %5zu hits\n", pointNs, pointHits / ROUNDS);
+        printf("  swept test, broadphase   %10.0f ns/projectile  %5zu hits  (+ %.0f ns a tick to index)\n", sweptNs, sweptHits / ROUNDS, indexNs);
+        return 0;
+    }
+
+    struct Benchmark
+    {
+        const char *name;
+        int (*run)(int argc, char *argv[]);
+    };
+
+    const Benchmark BENCHMARKS[] = {
+        {"movement", benchMovement},
+        {"lanes", benchLanes},
+        {"env", benchEnv},
+        {"grid", benchGrid},
+        {"autopilot", benchAutopilot},
+        {"horde", benchHorde},
+        {"swarm", benchSwarm},
+        {"projectile", benchProjectile},
+    };
+}
+
+int runBench(int argc, char *argv[])
+{
+    if (argc > 0)
+    {
+        for (const Benchmark &bench : BENCHMARKS)
+        {
+            if (strcmp(argv[0], bench.name) == 0)
+            {
+                return bench.run(argc - 1, argv + 1);
+            }
+        }
+    }
+
+    fprintf(stderr, "usage: -bench <name> [args...]; benchmarks:");
+    for (const Benchmark &bench : BENCHMARKS)
+    {
+        fprintf(stderr, " %s", bench.name);
+    }
+    fprintf(stderr, "\n");
+    return 1;
+}
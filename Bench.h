@@ -0,0 +1,13 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+// Micro-benchmarks for the simulation's hot loops, run from the command line
+// as "GhostRacer -bench <name> [args...]" without opening a window.
+
+/*
+ * Run the benchmark named by argv[0] with the remaining arguments and print
+ * results to stdout. Returns the process exit status.
+ */
+int runBench(int argc, char *argv[]);
+
+#endif // BENCH_H_
@@ -0,0 +1,85 @@
+#include "Collision.h"
+#include "Actor.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define COLLISION_SSE2
+#endif
+
+/* Same arithmetic as Actor::isOverlapping so batched and single tests agree exactly */
+void overlapTarget(const double *x, const double *y, const double *radius, int count,
+                   double targetX, double targetY, double targetRadius, unsigned char *hits)
+{
+    int i = 0;
+
+#ifdef COLLISION_SSE2
+    // two candidates per iteration; clearing the sign bit gives abs()
+    const __m128d absMask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d tx = _mm_set1_pd(targetX);
+    const __m128d ty = _mm_set1_pd(targetY);
+    const __m128d tr = _mm_set1_pd(targetRadius);
+    const __m128d xScale = _mm_set1_pd(Actor::X_SCALE);
+    const __m128d yScale = _mm_set1_pd(Actor::Y_SCALE);
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d deltaX = _mm_and_pd(_mm_sub_pd(tx, _mm_loadu_pd(x + i)), absMask);
+        __m128d deltaY = _mm_and_pd(_mm_sub_pd(ty, _mm_loadu_pd(y + i)), absMask);
+        __m128d radiusSum = _mm_add_pd(tr, _mm_loadu_pd(radius + i));
+        __m128d inX = _mm_cmplt_pd(deltaX, _mm_mul_pd(radiusSum, xScale));
+        __m128d inY = _mm_cmplt_pd(deltaY, _mm_mul_pd(radiusSum, yScale));
+        int mask = _mm_movemask_pd(_mm_and_pd(inX, inY));
+        hits[i] = mask & 1;
+        hits[i + 1] = (mask >> 1) & 1;
+    }
+#endif
+
+    // scalar tail (or everything, without SSE2)
+    for (; i < count; ++i)
+    {
+        double deltaX = std::abs(targetX - x[i]);
+        double deltaY = std::abs(targetY - y[i]);
+        double radiusSum = targetRadius + radius[i];
+        hits[i] = (deltaX < radiusSum * Actor::X_SCALE) & (deltaY < radiusSum * Actor::Y_SCALE);
+    }
+}
+
+namespace
+{
+    /*
+     * Narrow [enter, exit] to the part of the segment inside one axis' slab,
+     * for a segment starting @param start from the box centre and moving
+     * @param delta along the axis; false once nothing is left
+     */
+    bool clipToSlab(double start, double delta, double halfExtent, double &enter, double &exit)
+    {
+        if (delta == 0)
+        {
+            return std::abs(start) < halfExtent;
+        }
+        double first = (-halfExtent - start) / delta;
+        double last = (halfExtent - start) / delta;
+        if (first > last)
+        {
+            std::swap(first, last);
+        }
+        enter = std::max(enter, first);
+        exit = std::min(exit, last);
+        return enter < exit;
+    }
+}
+
+/* Slab test: the segment is inside the box where it is inside both axes' slabs */
+double segmentEntry(double x0, double y0, double x1, double y1,
+                    double centerX, double centerY, double halfWidth, double halfHeight)
+{
+    double enter = 0;
+    double exit = 1;
+    if (!clipToSlab(x0 - centerX, x1 - x0, halfWidth, enter, exit) ||
+        !clipToSlab(y0 - centerY, y1 - y0, halfHeight, enter, exit))
+    {
+        return SEGMENT_MISSES;
+    }
+    return enter;
+}
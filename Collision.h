@@ -0,0 +1,28 @@
+#ifndef COLLISION_H_
+#define COLLISION_H_
+
+// Batched and swept versions of the overlap test in Actor::isOverlapping: over
+// contiguous arrays of candidate positions and radii, and along a segment.
+
+/*
+ * Set hits[i] to 1 if candidate i overlaps the target, 0 otherwise
+ * @param x, y, radius: candidate positions and radii, count entries each
+ * @param targetX, targetY, targetRadius: the actor everything is tested against
+ */
+void overlapTarget(const double *x, const double *y, const double *radius, int count,
+                   double targetX, double targetY, double targetRadius, unsigned char *hits);
+
+// segmentEntry's answer for a segment that never enters the box
+const double SEGMENT_MISSES = 2;
+
+/*
+ * Fraction of the way along the segment from (x0, y0) to (x1, y1) where it
+ * first enters the open box centred on (centerX, centerY) with half extents
+ * @param halfWidth and @param halfHeight (the region Actor::isOverlapping
+ * tests), 0 if it starts inside, or SEGMENT_MISSES. A segment of length 0 is
+ * the plain point test.
+ */
+double segmentEntry(double x0, double y0, double x1, double y1,
+                    double centerX, double centerY, double halfWidth, double halfHeight);
+
+#endif // COLLISION_H_
@@ -81,8 +81,9 @@ int randInt(int min, int max)
 {
     if (max < min)
         std::swap(max, min);
-    static std::random_device rd;
-    static std::default_random_engine generator(rd());
+    // per thread, so worlds running on separate threads don't share an engine
+    thread_local std::random_device rd;
+    thread_local std::default_random_engine generator(rd());
     std::uniform_int_distribution<> distro(min, max);
     return distro(generator);
 }
@@ -6,6 +6,7 @@
 #include "SoundFX.h"
 #include "SpriteManager.h"
 #include <string>
+#include <string_view>
 #include <map>
 #include <utility>
 #include <cstdlib>
@@ -60,8 +61,8 @@ struct SpriteInfo
 };
 
 static void convertToGlutCoords(double x, double y, double& gx, double& gy, double& gz);
-static void drawPrompt(string mainMessage, string secondMessage);
-static void drawScoreAndLives(string);
+static void drawPrompt(GlyphAtlas& glyphs, const string& mainMessage, const string& secondMessage);
+static void drawScoreAndLives(GlyphAtlas& glyphs, string_view);
 
 enum GameController::GameControllerState : int {
     welcome, contgame, finishedlevel, init, cleanup, makemove, animate, gameover, prompt, quit, not_applicable
@@ -138,6 +139,16 @@ static void specialKeyboardEventCallback(int key, int x, int y)
 	Game().specialKeyboardEvent(key, x, y);
 }
 
+static void keyboardUpEventCallback(unsigned char key, int x, int y)
+{
+	Game().keyboardUpEvent(key, x, y);
+}
+
+static void specialKeyboardUpEventCallback(int key, int x, int y)
+{
+	Game().specialKeyboardUpEvent(key, x, y);
+}
+
 void GameController::timerFuncCallback(int)
 {
 	Game().doSomething();
@@ -146,10 +157,11 @@ void GameController::timerFuncCallback(int)
 
 void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTitle)
 {
-	gw->setController(this);
+	  // a world may come with services of its own that wrap this controller, like the autopilot
+	if (gw->services() == nullptr)
+		gw->setServices(this);
 	m_gw = gw;
 	setGameState(welcome);
-	m_lastKeyHit = INVALID_KEY;
 	m_singleStep = false;
 	m_curIntraFrameTick = 0;
 	m_playerWon = false;
@@ -165,6 +177,8 @@ void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTit
 
 	glutKeyboardFunc(keyboardEventCallback);
 	glutSpecialFunc(specialKeyboardEventCallback);
+	glutKeyboardUpFunc(keyboardUpEventCallback);
+	glutSpecialUpFunc(specialKeyboardUpEventCallback);
 	glutReshapeFunc(reshapeCallback);
 	glutDisplayFunc(doSomethingCallback);
 	glutTimerFunc(MS_PER_FRAME, timerFuncCallback, 0);
@@ -174,31 +188,83 @@ void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTit
 	delete m_gw;
 }
 
-void GameController::keyboardEvent(unsigned char key, int /* x */, int /* y */)
+  // the game key a typed character stands for
+static int gameKeyFor(unsigned char key)
 {
 	switch (key)
 	{
-		case 'a': case '4': m_lastKeyHit = KEY_PRESS_LEFT;	break;
-		case 'd': case '6': m_lastKeyHit = KEY_PRESS_RIGHT; break;
-		case 'w': case '8': m_lastKeyHit = KEY_PRESS_UP;	break;
-		case 's': case '2': m_lastKeyHit = KEY_PRESS_DOWN;	break;
-		case 't':			m_lastKeyHit = KEY_PRESS_TAB;	break;
-		case 'f':			m_singleStep = true;			break;
-		case 'r':			m_singleStep = false;			break;
-		case 'q': case 'Q': setGameState(quit);				break;
-		default:			m_lastKeyHit = key;				break;
+		case 'a': case '4': return KEY_PRESS_LEFT;
+		case 'd': case '6': return KEY_PRESS_RIGHT;
+		case 'w': case '8': return KEY_PRESS_UP;
+		case 's': case '2': return KEY_PRESS_DOWN;
+		case 't':			return KEY_PRESS_TAB;
+		default:			return key;
 	}
 }
 
-void GameController::specialKeyboardEvent(int key, int /* x */, int /* y */)
+  // the game key a special key stands for, or INVALID_KEY
+static int gameKeyForSpecial(int key)
 {
 	switch (key)
 	{
-		case GLUT_KEY_LEFT:	 m_lastKeyHit = KEY_PRESS_LEFT;	 break;
-		case GLUT_KEY_RIGHT: m_lastKeyHit = KEY_PRESS_RIGHT; break;
-		case GLUT_KEY_UP:	 m_lastKeyHit = KEY_PRESS_UP;	 break;
-		case GLUT_KEY_DOWN:	 m_lastKeyHit = KEY_PRESS_DOWN;	 break;
-		default:			 m_lastKeyHit = INVALID_KEY;	 break;
+		case GLUT_KEY_LEFT:	 return KEY_PRESS_LEFT;
+		case GLUT_KEY_RIGHT: return KEY_PRESS_RIGHT;
+		case GLUT_KEY_UP:	 return KEY_PRESS_UP;
+		case GLUT_KEY_DOWN:	 return KEY_PRESS_DOWN;
+		default:			 return INVALID_KEY;
+	}
+}
+
+  // keys the controller acts on itself (single-step, resume, quit) rather than the game
+static bool isControllerKey(int key)
+{
+	return key == 'f'  ||  key == 'r'  ||  key == 'q'  ||  key == 'Q';
+}
+
+  // Callbacks only push onto m_inputQueue, controller keys included, so they
+  // touch no state the game loop reads and may run on a thread of their own
+void GameController::keyboardEvent(unsigned char key, int /* x */, int /* y */)
+{
+	m_inputQueue.push(InputEvent{ inputClockNs(), gameKeyFor(key), true });
+}
+
+void GameController::specialKeyboardEvent(int key, int /* x */, int /* y */)
+{
+	int gameKey = gameKeyForSpecial(key);
+	if (gameKey != INVALID_KEY)
+		m_inputQueue.push(InputEvent{ inputClockNs(), gameKey, true });
+}
+
+void GameController::keyboardUpEvent(unsigned char key, int /* x */, int /* y */)
+{
+	if (!isControllerKey(key))
+		m_inputQueue.push(InputEvent{ inputClockNs(), gameKeyFor(key), false });
+}
+
+void GameController::specialKeyboardUpEvent(int key, int /* x */, int /* y */)
+{
+	int gameKey = gameKeyForSpecial(key);
+	if (gameKey != INVALID_KEY)
+		m_inputQueue.push(InputEvent{ inputClockNs(), gameKey, false });
+}
+
+  // Move the events that happened by now from the queue into m_input, acting
+  // on controller keys here, on the game loop's thread; any stamped later
+  // (once the keyboard runs on a thread of its own) wait for the next drain,
+  // so a tick never sees half of a later moment's input
+void GameController::drainInput()
+{
+	uint64_t now = inputClockNs();
+	for (const InputEvent* event = m_inputQueue.front(); event != nullptr && event->timeNs <= now; event = m_inputQueue.front())
+	{
+		switch (event->key)
+		{
+			case 'f':			m_singleStep = true;	break;
+			case 'r':			m_singleStep = false;	break;
+			case 'q': case 'Q': setGameState(quit);		break;
+			default:			m_input.apply(*event);	break;
+		}
+		m_inputQueue.pop();
 	}
 }
 
@@ -229,6 +295,9 @@ void GameController::quitGame()
 
 void GameController::doSomething()
 {
+	  // so single-stepping and quitting take effect even while nothing asks for keys
+	drainInput();
+
 	switch (m_gameState)
 	{
 		case not_applicable:
@@ -301,7 +370,7 @@ void GameController::doSomething()
 			m_nextStateAfterPrompt = quit;
 			break;
 		case prompt:
-			drawPrompt(m_mainMessage, m_secondMessage);
+			drawPrompt(m_glyphAtlas, m_mainMessage, m_secondMessage);
 			{
 				int key;
 				if (getLastKey(key) && key == '\r')
@@ -330,6 +399,7 @@ void GameController::doSomething()
 			break;
 		case quit:
             SoundFX().abortClip();
+			m_glyphAtlas.release();
 			glutLeaveMainLoop();
 			break;
 	}
@@ -338,6 +408,7 @@ void GameController::doSomething()
 
 void GameController::displayGamePlay()
 {
+	m_glyphAtlas.prepare();
 	glEnable(GL_DEPTH_TEST); // must be done each time before displaying graphics or gets disabled for some reason
 	glLoadIdentity();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -350,9 +421,9 @@ void GameController::displayGamePlay()
 #pragma GCC diagnostic pop
 #endif
 
-	for (int i = 4 /* NUM_DEPTHS */ - 1; i >= 0; --i)
+	for (int i = GraphScene::NUM_DEPTHS - 1; i >= 0; --i)
 	{
-		std::set<GraphObject*> &graphObjects = GraphObject::getGraphObjects(i);
+		std::set<GraphObject*> &graphObjects = m_gw->scene().layer(i);
 
 		for (auto it = graphObjects.begin(); it != graphObjects.end(); it++)
 		{
@@ -371,9 +442,29 @@ void GameController::displayGamePlay()
 				m_spriteManager.plotSprite(imageID, cur->getAnimationNumber() % m_spriteManager.getNumFrames(imageID), gx, gy, gz, angle, cur->getSize());
 			}
 		}
+
+		for (const SpriteBatch* batch : m_gw->scene().batches(i))
+		{
+			int imageID = batch->imageID();
+			unsigned int numFrames = m_spriteManager.getNumFrames(imageID);
+			if (numFrames == 0)
+				continue;
+
+			m_batchSprites.resize(batch->spriteCount());
+			for (size_t k = 0; k < m_batchSprites.size(); k++)
+			{
+				SpriteManager::BatchSprite& sprite = m_batchSprites[k];
+				double x, y;
+				unsigned int animationNumber;
+				batch->sprite(k, x, y, sprite.angleDegrees, animationNumber);
+				convertToGlutCoords(x, y, sprite.gx, sprite.gy, sprite.gz);
+				sprite.frame = animationNumber % numFrames;
+			}
+			m_spriteManager.plotSpriteBatch(imageID, m_batchSprites.data(), m_batchSprites.size(), batch->spriteSize());
+		}
 	}
 
-	drawScoreAndLives(m_gameStatText);
+	drawScoreAndLives(m_glyphAtlas, m_gameStatText);
 
 	glutSwapBuffers();
 }
@@ -403,46 +494,18 @@ static void convertToGlutCoords(double x, double y, double& gx, double& gy, doub
 	gz = .6 * VISIBLE_MIN_Z;
 }
 
-static void doOutputStroke(double x, double y, double z, double size, const char* str, bool centered)
-{
-	if (centered)
-	{
-		double len = glutStrokeLength(GLUT_STROKE_ROMAN, reinterpret_cast<const unsigned char*>(str)) / FONT_SCALEDOWN;
-		x = -len / 2;
-		size = 1;
-	}
-	GLfloat scaledSize = static_cast<GLfloat>(size / FONT_SCALEDOWN);
-	glPushMatrix();
-	glLineWidth(1);
-	glLoadIdentity();
-	glTranslatef(static_cast<GLfloat>(x), static_cast<GLfloat>(y), static_cast<GLfloat>(z));
-	glScalef(scaledSize, scaledSize, scaledSize);
-	for ( ; *str != '\0'; str++)
-		glutStrokeCharacter(GLUT_STROKE_ROMAN, *str);
-	glPopMatrix();
-}
-
-//static void outputStroke(double x, double y, double z, double size, const char* str)
-//{
-//	doOutputStroke(x, y, z, size, str, false);
-//}
-
-static void outputStrokeCentered(double y, double z, const char* str)
-{
-	doOutputStroke(0, y, z, 1, str, true);
-}
-
-static void drawPrompt(string mainMessage, string secondMessage)
+static void drawPrompt(GlyphAtlas& glyphs, const string& mainMessage, const string& secondMessage)
 {
+	glyphs.prepare();
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glColor3f (1.0, 1.0, 1.0);
 	glLoadIdentity ();
-	outputStrokeCentered(1, -5, mainMessage.c_str());
-	outputStrokeCentered(-1, -5, secondMessage.c_str());
+	glyphs.drawCentered(GlyphAtlas::PROMPT_MAIN, mainMessage, 1, -5, FONT_SCALEDOWN);
+	glyphs.drawCentered(GlyphAtlas::PROMPT_SECOND, secondMessage, -1, -5, FONT_SCALEDOWN);
 	glutSwapBuffers();
 }
 
-static void drawScoreAndLives(string gameStatText)
+static void drawScoreAndLives(GlyphAtlas& glyphs, string_view gameStatText)
 {
 	static int RATE = 1;
 	static GLfloat rgb[3] =
@@ -457,5 +520,5 @@ static void drawScoreAndLives(string gameStatText)
 		rgb[k] = static_cast<GLfloat>(strength);
 	}
 	glColor3f(rgb[0], rgb[1], rgb[2]);
-	outputStrokeCentered(SCORE_Y, SCORE_Z, gameStatText.c_str());
+	glyphs.drawCentered(GlyphAtlas::STATUS, gameStatText, SCORE_Y, SCORE_Z, FONT_SCALEDOWN);
 }
@@ -2,8 +2,12 @@
 #define GAMECONTROLLER_H_
 
 #include "SpriteManager.h"
+#include "GlyphAtlas.h"
+#include "GameServices.h"
 #include <string>
+#include <string_view>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <sstream>
 const int INVALID_KEY = 0;
@@ -11,25 +15,28 @@ const int INVALID_KEY = 0;
 class GraphObject;
 class GameWorld;
 
-class GameController
+class GameController : public GameServices
 {
   public:
 	void run(int argc, char* argv[], GameWorld* gw, std::string windowTitle);
 
-	bool getLastKey(int& value)
+	  // the last key pressed since the last call or poll, for prompts and single-stepping
+	bool getLastKey(int& value) override
 	{
-		if (m_lastKeyHit != INVALID_KEY)
-		{
-			value = m_lastKeyHit;
-			m_lastKeyHit = INVALID_KEY;
-			return true;
-		}
-		return false;
+		drainInput();
+		return m_input.takeLastPress(value);
 	}
 
-	void playSound(int soundID);
+	void pollInput(InputState& state) override
+	{
+		drainInput();
+		state = m_input;
+		m_input.beginTick();
+	}
+
+	void playSound(int soundID) override;
 
-	void setGameStatText(std::string text)
+	void setGameStatText(std::string_view text) override
 	{
 		m_gameStatText = text;
 	}
@@ -39,8 +46,10 @@ class GameController
 	void reshape(int w, int h);
 	void keyboardEvent(unsigned char key, int x, int y);
 	void specialKeyboardEvent(int key, int x, int y);
+	void keyboardUpEvent(unsigned char key, int x, int y);
+	void specialKeyboardUpEvent(int key, int x, int y);
 
-    void quitGame();
+    void quitGame() override;
 
 	  // Meyers singleton pattern
 	static GameController& getInstance()
@@ -50,7 +59,7 @@ class GameController
 	}
 
 	static void timerFuncCallback(int nothing);
-	void setMsPerTick(int ms_per_tick) { m_ms_per_tick = ms_per_tick;  }
+	void setMsPerTick(int ms_per_tick) override { m_ms_per_tick = ms_per_tick;  }
 
 private:
     enum GameControllerState : int;
@@ -59,9 +68,11 @@ private:
 	GameControllerState	m_gameState;
 	GameControllerState	m_nextStateAfterPrompt;
 	GameControllerState	m_nextStateAfterAnimate;
-	int			m_lastKeyHit;
+	  // keyboard callbacks push, the game loop drains into m_input
+	InputQueue	m_inputQueue;
+	InputState	m_input;
 	bool		m_singleStep;
-	std::string m_gameStatText;
+	std::string_view m_gameStatText;
 	std::string m_mainMessage;
 	std::string m_secondMessage;
 	int			m_curIntraFrameTick;
@@ -70,10 +81,13 @@ private:
 	SoundMapType m_soundMap;
 	bool		m_playerWon;
 	SpriteManager m_spriteManager;
+	std::vector<SpriteManager::BatchSprite> m_batchSprites;	// reused by every batch drawn
+	GlyphAtlas	m_glyphAtlas;
 
     void setGameState(GameControllerState s);
 
 	void initDrawersAndSounds();
+	void drainInput();
 	void displayGamePlay();
 
 	static const int kDefaultMsPerTick = 10;
@@ -0,0 +1,33 @@
+#ifndef GAMESERVICES_H_
+#define GAMESERVICES_H_
+
+#include "InputQueue.h"
+#include <string_view>
+
+  // What a GameWorld needs from whatever is running it: keys, sounds and the
+  // status line. GameController provides them for the windowed game. A world
+  // with no services runs headless: no keys arrive and nothing is played.
+class GameServices
+{
+  public:
+	virtual ~GameServices() {}
+
+	virtual bool getLastKey(int& value) = 0;
+	  // Start @param state on the tick about to run, with what the keyboard did
+	  // since the last poll. By default the key getLastKey hands over counts as
+	  // a tap, which is all a source that picks one key a tick needs.
+	virtual void pollInput(InputState& state)
+	{
+		state.beginTick();
+		int key;
+		if (getLastKey(key))
+			state.tap(key);
+	}
+	virtual void playSound(int soundID) = 0;
+	  // text must stay valid until the next call
+	virtual void setGameStatText(std::string_view text) = 0;
+	virtual void setMsPerTick(int ms_per_tick) = 0;
+	virtual void quitGame() = 0;
+};
+
+#endif // GAMESERVICES_H_
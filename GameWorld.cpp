@@ -1,32 +1,54 @@
 #include "GameWorld.h"
-#include "GameController.h"
+#include "AllocTracker.h"
 #include <string>
 #include <cstdlib>
 using namespace std;
 
 bool GameWorld::getKey(int& value)
 {
-	bool gotKey = m_controller->getLastKey(value);
+	if (m_services == nullptr)
+		return false;
+
+	bool gotKey = m_services->getLastKey(value);
 
 	if (gotKey)
 	{
 		if (value == 'q'  ||  value == '\x03')  // CTRL-C
-			m_controller->quitGame();
+			m_services->quitGame();
 	}
 	return gotKey;
 }
 
+void GameWorld::pollInput()
+{
+	if (m_services == nullptr)
+	{
+		m_input.beginTick();
+		return;
+	}
+
+	m_services->pollInput(m_input);
+	if (m_input.pressCount('q') != 0  ||  m_input.pressCount('\x03') != 0)  // CTRL-C
+		m_services->quitGame();
+}
+
 void GameWorld::playSound(int soundID)
 {
-	m_controller->playSound(soundID);
+	if (m_services == nullptr)
+		return;
+
+	AllocPhaseScope soundPhase(ALLOC_PHASE_SOUND);
+	m_services->playSound(soundID);
 }
 
-void GameWorld::setGameStatText(string text)
+void GameWorld::setGameStatText(string_view text)
 {
-	m_controller->setGameStatText(text);
+	if (m_services != nullptr)
+		m_services->setGameStatText(text);
 }
 
 void GameWorld::setMsPerTick(int ms_per_tick)
 {
-	m_controller->setMsPerTick(ms_per_tick);
+	if (m_services != nullptr)
+		m_services->setMsPerTick(ms_per_tick);
 }
@@ -2,19 +2,20 @@
 #define GAMEWORLD_H_
 
 #include "GameConstants.h"
+#include "GameServices.h"
+#include "GraphScene.h"
 #include <string>
+#include <string_view>
 
 const int START_PLAYER_LIVES = 3;
 
-class GameController;
-
 class GameWorld
 {
 public:
 
 	GameWorld(std::string assetPath)
 	 : m_lives(START_PLAYER_LIVES), m_score(0), m_level(1),
-	   m_controller(nullptr), m_assetPath(assetPath)
+	   m_services(nullptr), m_assetPath(assetPath)
 	{
 	}
 
@@ -26,9 +27,19 @@ public:
 	virtual int move() = 0;
 	virtual void cleanUp() = 0;
 
-	void setGameStatText(std::string text);
+	  // text must stay valid until the next call; the controller keeps the view
+	void setGameStatText(std::string_view text);
 
 	bool getKey(int& value);
+	  // Take the input gathered by the services since the last poll; input()
+	  // reads it until the next poll. Every key pressed since the last poll is
+	  // there, in order. Only poll on a tick that acts on the input, or the
+	  // presses are lost.
+	void pollInput();
+	const InputState& input() const
+	{
+		return m_input;
+	}
 	void playSound(int soundID);
 
 	int getLevel() const
@@ -72,10 +83,30 @@ public:
 	{
 		++m_level;
 	}
+
+	  // back to level 1 with full lives and no score, for running game after game
+	void restartGame()
+	{
+		m_lives = START_PLAYER_LIVES;
+		m_score = 0;
+		m_level = 1;
+	}
  
-	void setController(GameController* controller)
+	  // nullptr (the default) runs the world headless
+	void setServices(GameServices* services)
+	{
+		m_services = services;
+	}
+
+	GameServices* services() const
+	{
+		return m_services;
+	}
+
+	  // the objects this world draws
+	GraphScene& scene()
 	{
-		m_controller = controller;
+		return m_scene;
 	}
 
 	std::string assetPath() const
@@ -88,8 +119,10 @@ private:
 	int				m_lives;
 	int				m_score;
 	int				m_level;
-	GameController* m_controller;
+	GameServices*	m_services;
+	InputState		m_input;
 	std::string		m_assetPath;
+	GraphScene		m_scene;
 };
 
 #endif // GAMEWORLD_H_
@@ -0,0 +1,237 @@
+#ifndef GLYPHATLAS_H_
+#define GLYPHATLAS_H_
+
+#include "freeglut.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+
+  // Renders the GLUT stroke font into an alpha texture once, then draws
+  // strings as a single batch of textured quads. Each caller-chosen slot
+  // remembers the last string it drew, so unchanged text reuses its layout.
+
+class GlyphAtlas
+{
+public:
+
+	enum Slot { STATUS, PROMPT_MAIN, PROMPT_SECOND, NUM_SLOTS };
+
+	GlyphAtlas()
+	 : m_built(false), m_textureID(0)
+	{
+	}
+
+	  // Frees the texture; call while the window (and so the GL context) still
+	  // exists. There's no destructor doing this because the atlas outlives the
+	  // window: GameController is a static, destroyed after glutLeaveMainLoop.
+	void release()
+	{
+		if (m_built)
+			glDeleteTextures(1, &m_textureID);
+		m_built = false;
+	}
+
+	  // Must be called at the start of a frame, before it clears the screen:
+	  // the first call uses the back buffer as scratch space to rasterize glyphs.
+	void prepare()
+	{
+		if (!m_built)
+			build();
+	}
+
+	  // Same placement as the stroke text it replaces: centered on x = 0 at (y, z),
+	  // one stroke unit scaled down by scaleDown.
+	void drawCentered(Slot slot, std::string_view str, double y, double z, double scaleDown)
+	{
+		if (!m_built)
+			return;
+
+		Layout& layout = m_layouts[slot];
+		if (!layout.valid || layout.text != str)
+			buildLayout(layout, str);
+		if (layout.vertices.empty())
+			return;
+
+		GLfloat scale = static_cast<GLfloat>(1 / scaleDown);
+		glPushMatrix();
+		glLoadIdentity();
+		glTranslatef(static_cast<GLfloat>(-layout.width / scaleDown / 2), static_cast<GLfloat>(y), static_cast<GLfloat>(z));
+		glScalef(scale, scale, scale);
+
+		glPushAttrib(GL_COLOR_BUFFER_BIT | GL_ENABLE_BIT | GL_TEXTURE_BIT);
+		glEnable(GL_TEXTURE_2D);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glBindTexture(GL_TEXTURE_2D, m_textureID);
+		glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, layout.vertices.data());
+		glTexCoordPointer(2, GL_FLOAT, 0, layout.texCoords.data());
+		glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(layout.vertices.size() / 2));
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+
+		glPopAttrib();
+		glPopMatrix();
+	}
+
+private:
+
+	struct Layout
+	{
+		Layout() : valid(false), width(0) {}
+		bool				valid;
+		std::string			text;
+		double				width;		// total advance in stroke units
+		std::vector<GLfloat> vertices;	// x,y pairs in stroke units, 4 per glyph
+		std::vector<GLfloat> texCoords;
+	};
+
+	static const int FIRST_CHAR = 32;
+	static const int LAST_CHAR = 126;
+	static const int NUM_CHARS = LAST_CHAR - FIRST_CHAR + 1;
+	static const int COLUMNS = 16;
+	static const int ROWS = (NUM_CHARS + COLUMNS - 1) / COLUMNS;
+	static const int CELL_WIDTH = 40;	// pixels; widest roman glyph is ~105 units
+	static const int CELL_HEIGHT = 48;
+	static const int PAD = 2;			// pixels of slack around each glyph's advance box
+	static const int TEX_WIDTH = 1024;
+	static const int TEX_HEIGHT = 512;
+	static constexpr double ASCENT = 119.05;	// GLUT_STROKE_ROMAN extents in stroke units
+	static constexpr double DESCENT = 33.33;
+	static constexpr double PIXELS_PER_UNIT = (CELL_HEIGHT - 2 * PAD) / (ASCENT + DESCENT);
+	static constexpr GLfloat LINE_WIDTH = 2.5f;	// keeps strokes visible once minified
+
+	bool	m_built;
+	GLuint	m_textureID;
+	int		m_advance[NUM_CHARS];	// stroke units
+	Layout	m_layouts[NUM_SLOTS];
+
+	void build()
+	{
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		int atlasWidth = COLUMNS * CELL_WIDTH;
+		int atlasHeight = ROWS * CELL_HEIGHT;
+		if (viewport[2] < atlasWidth || viewport[3] < atlasHeight)
+			return;	// window too small to rasterize into yet; try again next frame
+
+		glPushAttrib(GL_ALL_ATTRIB_BITS);
+		glMatrixMode(GL_PROJECTION);
+		glPushMatrix();
+		glLoadIdentity();
+		glOrtho(0, viewport[2], 0, viewport[3], -1, 1);
+		glMatrixMode(GL_MODELVIEW);
+		glPushMatrix();
+
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_TEXTURE_2D);
+		glEnable(GL_LINE_SMOOTH);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glLineWidth(LINE_WIDTH);
+		glClearColor(0, 0, 0, 0);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glColor3f(1.0, 1.0, 1.0);
+
+		GLfloat scale = static_cast<GLfloat>(PIXELS_PER_UNIT);
+		for (int k = 0; k < NUM_CHARS; k++)
+		{
+			int c = FIRST_CHAR + k;
+			m_advance[k] = glutStrokeWidth(GLUT_STROKE_ROMAN, c);
+			glLoadIdentity();
+			glTranslatef(static_cast<GLfloat>(cellX(k) + PAD), static_cast<GLfloat>(cellY(k) + PAD + DESCENT * PIXELS_PER_UNIT), 0);
+			glScalef(scale, scale, scale);
+			glutStrokeCharacter(GLUT_STROKE_ROMAN, c);
+		}
+
+		  // the red channel of white-on-black strokes is the glyph coverage
+		std::unique_ptr<unsigned char[]> pixels(new unsigned char[TEX_WIDTH * TEX_HEIGHT]());
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glPixelStorei(GL_PACK_ROW_LENGTH, TEX_WIDTH);
+		glReadBuffer(GL_BACK);
+		glReadPixels(viewport[0], viewport[1], atlasWidth, atlasHeight, GL_RED, GL_UNSIGNED_BYTE, pixels.get());
+		glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		glMatrixMode(GL_MODELVIEW);
+		glPopMatrix();
+		glMatrixMode(GL_PROJECTION);
+		glPopMatrix();
+		glMatrixMode(GL_MODELVIEW);
+		glPopAttrib();
+
+		glGenTextures(1, &m_textureID);
+		glBindTexture(GL_TEXTURE_2D, m_textureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#ifdef __APPLE__
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, TEX_WIDTH, TEX_HEIGHT, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.get());
+		glGenerateMipmap(GL_TEXTURE_2D);
+#else
+		gluBuild2DMipmaps(GL_TEXTURE_2D, GL_ALPHA, TEX_WIDTH, TEX_HEIGHT, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.get());
+#endif
+		m_built = true;
+	}
+
+	void buildLayout(Layout& layout, std::string_view str)
+	{
+		layout.text.assign(str.data(), str.size());
+		layout.vertices.clear();
+		layout.texCoords.clear();
+
+		const GLfloat padUnits = static_cast<GLfloat>(PAD / PIXELS_PER_UNIT);
+		const GLfloat bottom = static_cast<GLfloat>(-DESCENT) - padUnits;
+		const GLfloat top = static_cast<GLfloat>(ASCENT) + padUnits;
+		double pen = 0;
+		for (char ch : str)
+		{
+			int k = static_cast<unsigned char>(ch) - FIRST_CHAR;
+			if (k < 0 || k >= NUM_CHARS)
+				continue;
+			if (ch != ' ')
+			{
+				GLfloat left = static_cast<GLfloat>(pen) - padUnits;
+				GLfloat right = static_cast<GLfloat>(pen + m_advance[k]) + padUnits;
+				GLfloat u0 = static_cast<GLfloat>(cellX(k)) / TEX_WIDTH;
+				GLfloat u1 = static_cast<GLfloat>(cellX(k) + 2 * PAD + m_advance[k] * PIXELS_PER_UNIT) / TEX_WIDTH;
+				GLfloat v0 = static_cast<GLfloat>(cellY(k)) / TEX_HEIGHT;
+				GLfloat v1 = static_cast<GLfloat>(cellY(k) + CELL_HEIGHT) / TEX_HEIGHT;
+				addVertex(layout, left, bottom, u0, v0);
+				addVertex(layout, right, bottom, u1, v0);
+				addVertex(layout, right, top, u1, v1);
+				addVertex(layout, left, top, u0, v1);
+			}
+			pen += m_advance[k];
+		}
+		layout.width = pen;
+		layout.valid = true;
+	}
+
+	static void addVertex(Layout& layout, GLfloat x, GLfloat y, GLfloat u, GLfloat v)
+	{
+		layout.vertices.push_back(x);
+		layout.vertices.push_back(y);
+		layout.texCoords.push_back(u);
+		layout.texCoords.push_back(v);
+	}
+
+	static int cellX(int k)
+	{
+		return (k % COLUMNS) * CELL_WIDTH;
+	}
+
+	static int cellY(int k)
+	{
+		return (k / COLUMNS) * CELL_HEIGHT;
+	}
+};
+
+#endif // GLYPHATLAS_H_
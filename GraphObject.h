@@ -3,6 +3,9 @@
 
 #include "SpriteManager.h"
 #include "GameConstants.h"
+#include "AllocTracker.h"
+#include "GraphScene.h"
+#include "Trig.h"
 
 #include <set>
 #include <cmath>
@@ -18,21 +21,25 @@ class GraphObject
 	static const int up = 90;
 	static const int down = 270;
 
-	GraphObject(int imageID, double startX, double startY, int dir = 0, double size = 1.0, unsigned int depth = 0)
-	 : m_imageID(imageID), m_visible(true), m_x(startX), m_y(startY),
-	   m_destX(startX), m_destY(startY), m_brightness(1.0),
+	static const int RADIUS_PER_UNIT = 8;
+
+	  // the object is drawn as part of @param scene until it is destroyed
+	GraphObject(GraphScene& scene, int imageID, double startX, double startY, int dir = 0, double size = 1.0, unsigned int depth = 0)
+	 : m_scene(&scene), m_imageID(imageID), m_visible(true), m_x(startX), m_y(startY),
+	   m_brightness(1.0),
 	   m_animationNumber(0), m_direction(dir), m_size(size), m_depth(depth)
 	{
 		if (m_size <= 0)
 			m_size = 1;
 
-		getGraphObjects(m_depth).insert(this);
+		AllocPhaseScope scenePhase(ALLOC_PHASE_SCENE);
+		m_scene->layer(m_depth).insert(this);
 		setVisible(true);
 	}
 
 	virtual ~GraphObject()
 	{
-		getGraphObjects(m_depth).erase(this);
+		m_scene->layer(m_depth).erase(this);
 	}
 
 	void setVisible(bool shouldIDisplay)
@@ -45,24 +52,12 @@ class GraphObject
 		m_brightness = brightness;
 	}
 
-	double getX() const
-	{
-		  // If already moved but not yet animated, use new location anyway.
-		return m_destX;
-	}
-
-	double getY() const
-	{
-		  // If already moved but not yet animated, use new location anyway.
-		return m_destY;
-	}
-
-	virtual void moveTo(double x, double y)
-	{
-		m_destX = x;
-		m_destY = y;
-		increaseAnimationNumber();
-	}
+	  // Where the object logically is, which may be ahead of where it was last
+	  // animated. Subclasses own this state (actors keep it in their world's
+	  // ActorStore), so the scene graph doesn't hold a second copy.
+	virtual double getX() const = 0;
+	virtual double getY() const = 0;
+	virtual void moveTo(double x, double y) = 0;
 
 	virtual void moveAngle(int angle, int units = 1)
 	{
@@ -75,9 +70,8 @@ class GraphObject
 
 	virtual void getPositionInThisDirection(int angle, int units, double &dx, double &dy)
 	{
-		static const double PI = 4 * atan(1.0);
-		dx = (getX() + units * cos(angle*1.0 / 360 * 2 * PI));
-		dy = (getY() + units * sin(angle*1.0 / 360 * 2 * PI));
+		dx = (getX() + units * cosDegrees(angle));
+		dy = (getY() + units * sinDegrees(angle));
 	}
 
 	void moveForward(int units = 1)
@@ -111,8 +105,7 @@ class GraphObject
 
 	double getRadius() const
 	{
-		const int kRaidusPerUnit = 8;
-		return kRaidusPerUnit * m_size;
+		return RADIUS_PER_UNIT * m_size;
 	}
 
 	  // The following should be used by only the framework, not the student
@@ -140,19 +133,8 @@ class GraphObject
 
 	void animate()
 	{
-		m_x = m_destX;
-		m_y = m_destY;
-//		moveALittle(m_x, m_destX);
-	//	moveALittle(m_y, m_destY);
-	}
-
-	static std::set<GraphObject*>& getGraphObjects(unsigned int layer)
-	{
-		static std::set<GraphObject*> graphObjects[NUM_DEPTHS];
-		if (layer < NUM_DEPTHS)
-			return graphObjects[layer];
-		else
-			return graphObjects[0];		// empty;
+		m_x = getX();
+		m_y = getY();
 	}
 
 	void increaseAnimationNumber()
@@ -173,13 +155,11 @@ private:
 	GraphObject(const GraphObject&);
 	GraphObject& operator=(const GraphObject&);
 
-	static const int NUM_DEPTHS = 4;
+	GraphScene*	m_scene;
 	int		m_imageID;
 	bool	m_visible;
 	double	m_x;
 	double	m_y;
-	double	m_destX;
-	double	m_destY;
 	double	m_brightness;
 	int	m_animationNumber;
 	int	m_direction;
@@ -0,0 +1,58 @@
+#ifndef GRAPHSCENE_H_
+#define GRAPHSCENE_H_
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+class GraphObject;
+
+  // Sprites that live outside the GraphObject sets, packed by whoever owns
+  // them, all of one image and size. The renderer draws a batch in one pass
+  // rather than one plot per sprite.
+class SpriteBatch
+{
+  public:
+	virtual ~SpriteBatch() {}
+	virtual int imageID() const = 0;
+	virtual double spriteSize() const = 0;
+	virtual size_t spriteCount() const = 0;
+	  // sprite i's position, direction, and animation counter (any value; the
+	  // renderer wraps it to the image's frames)
+	virtual void sprite(size_t i, double& x, double& y, int& direction, unsigned int& animationNumber) const = 0;
+};
+
+  // Every GraphObject a world has created, by depth, for the renderer to walk,
+  // plus the sprite batches drawn alongside them. Each GameWorld owns its own,
+  // so worlds in one process never see each other's objects.
+class GraphScene
+{
+  public:
+	static const unsigned int NUM_DEPTHS = 4;
+
+	std::set<GraphObject*>& layer(unsigned int depth)
+	{
+		if (depth < NUM_DEPTHS)
+			return m_layers[depth];
+		else
+			return m_layers[0];
+	}
+
+	  // draw @param batch at @param depth, after that depth's GraphObjects,
+	  // until the scene goes away; the caller keeps it alive that long
+	void addBatch(unsigned int depth, SpriteBatch* batch)
+	{
+		m_batches[depth < NUM_DEPTHS ? depth : 0].push_back(batch);
+	}
+
+	const std::vector<SpriteBatch*>& batches(unsigned int depth) const
+	{
+		return m_batches[depth < NUM_DEPTHS ? depth : 0];
+	}
+
+  private:
+	std::set<GraphObject*> m_layers[NUM_DEPTHS];
+	std::vector<SpriteBatch*> m_batches[NUM_DEPTHS];
+};
+
+#endif // GRAPHSCENE_H_
@@ -0,0 +1,194 @@
+#ifndef INPUTQUEUE_H_
+#define INPUTQUEUE_H_
+
+#include "GameConstants.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+  // nanoseconds on the clock input events are stamped with
+inline std::uint64_t inputClockNs()
+{
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct InputEvent
+{
+	std::uint64_t timeNs;	// inputClockNs() when it happened
+	int key;				// a KEY_PRESS_ constant or the character typed
+	bool down;				// pressed (or auto-repeated) rather than released
+};
+
+  // Input events on their way from the window system to the game, oldest
+  // first. Lock-free for one producer (the thread the keyboard callbacks run
+  // on) and one consumer (the thread that runs ticks), which may be the same
+  // thread or not. Nothing is overwritten: when the consumer falls CAPACITY
+  // events behind, new events are dropped and counted.
+class InputQueue
+{
+  public:
+	static const std::size_t CAPACITY = 256;
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "positions wrap by masking");
+
+	InputQueue()
+	 : m_head(0), m_tail(0), m_dropped(0)
+	{
+	}
+
+	  // producer only; false if the queue was full and @param event was dropped
+	bool push(const InputEvent& event)
+	{
+		std::size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == CAPACITY)
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		m_events[tail & (CAPACITY - 1)] = event;
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	  // consumer only: the oldest event, or nullptr if there is none; valid until pop
+	const InputEvent* front() const
+	{
+		std::size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return nullptr;
+		return &m_events[head & (CAPACITY - 1)];
+	}
+
+	  // consumer only: drop the event front() returned
+	void pop()
+	{
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	std::size_t dropped() const
+	{
+		return m_dropped.load(std::memory_order_relaxed);
+	}
+
+  private:
+	  // each side writes only its own index, on its own cache line
+	alignas(64) std::atomic<std::size_t> m_head;	// next event to read
+	alignas(64) std::atomic<std::size_t> m_tail;	// next entry to write
+	alignas(64) std::atomic<std::size_t> m_dropped;
+	InputEvent m_events[CAPACITY];
+};
+
+  // What the keyboard did over one tick: every key pressed since the last
+  // tick, in order, how often each was pressed, and which are held down now.
+  // A key pressed and released within one tick still counts as a press.
+class InputState
+{
+  public:
+	  // presses kept in order per tick; more still count, but aren't replayed
+	static const int MAX_ORDERED_PRESSES = 32;
+
+	InputState()
+	 : m_held(), m_pressCount(), m_presses(), m_numPresses(0)
+	{
+	}
+
+	  // start a new tick: forget the last one's presses; held keys stay held
+	void beginTick()
+	{
+		for (int i = 0; i < m_numPresses; i++)
+		{
+			int slot = slotOf(m_presses[i]);
+			if (slot >= 0)
+				m_pressCount[slot] = 0;
+		}
+		  // presses past the ordered ones left counts behind too
+		if (m_numPresses == MAX_ORDERED_PRESSES)
+		{
+			for (int slot = 0; slot < NUM_SLOTS; slot++)
+				m_pressCount[slot] = 0;
+		}
+		m_numPresses = 0;
+	}
+
+	void apply(const InputEvent& event)
+	{
+		int slot = slotOf(event.key);
+		if (!event.down)
+		{
+			if (slot >= 0)
+				m_held[slot] = false;
+			return;
+		}
+		if (slot >= 0)
+		{
+			m_held[slot] = true;
+			if (m_pressCount[slot] < UINT16_MAX)
+				m_pressCount[slot]++;
+		}
+		if (m_numPresses < MAX_ORDERED_PRESSES)
+			m_presses[m_numPresses++] = event.key;
+	}
+
+	  // @param key pressed and released, for sources that only know keys, not timing
+	void tap(int key)
+	{
+		apply(InputEvent{ inputClockNs(), key, true });
+		apply(InputEvent{ inputClockNs(), key, false });
+	}
+
+	  // the last key pressed this tick, if any, forgetting this tick's presses,
+	  // for callers that only want one key, like a prompt
+	bool takeLastPress(int& key)
+	{
+		if (m_numPresses == 0)
+			return false;
+		key = m_presses[m_numPresses - 1];
+		beginTick();
+		return true;
+	}
+
+	bool isHeld(int key) const
+	{
+		int slot = slotOf(key);
+		return slot >= 0 && m_held[slot];
+	}
+
+	int pressCount(int key) const
+	{
+		int slot = slotOf(key);
+		return (slot >= 0) ? m_pressCount[slot] : 0;
+	}
+
+	  // this tick's presses, oldest first
+	int numPresses() const
+	{
+		return m_numPresses;
+	}
+
+	int press(int i) const
+	{
+		return m_presses[i];
+	}
+
+  private:
+	  // characters 0-255, then the arrow keys
+	static const int NUM_ARROW_KEYS = KEY_PRESS_DOWN - KEY_PRESS_LEFT + 1;
+	static const int NUM_SLOTS = 256 + NUM_ARROW_KEYS;
+
+	bool			m_held[NUM_SLOTS];
+	std::uint16_t	m_pressCount[NUM_SLOTS];
+	int				m_presses[MAX_ORDERED_PRESSES];
+	int				m_numPresses;
+
+	static int slotOf(int key)
+	{
+		if (key >= 0 && key < 256)
+			return key;
+		if (key >= KEY_PRESS_LEFT && key <= KEY_PRESS_DOWN)
+			return 256 + key - KEY_PRESS_LEFT;
+		return -1;
+	}
+};
+
+#endif // INPUTQUEUE_H_
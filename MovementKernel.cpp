@@ -0,0 +1,229 @@
+#include "MovementKernel.h"
+#include "ActorStore.h"
+#include "ActorTraits.h"
+#include "GameConstants.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MOVEMENT_X86
+#endif
+
+namespace
+{
+    // ALIVE for types in the mask, 0 otherwise, so (table[type] & flags) filters a slot
+    static_assert(NUM_ACTOR_TYPES <= 16, "the AVX2 kernel looks types up with a 16-byte shuffle");
+    struct TypeTable
+    {
+        alignas(16) unsigned char bits[16];
+        constexpr TypeTable(ActorTypeMask mask) : bits()
+        {
+            for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+            {
+                bits[type] = isTypeIn(mask, type) ? ActorStore::ALIVE : 0;
+            }
+        }
+    };
+    constexpr TypeTable MOVES_IF_ALIVE(SCROLLING_TYPES);
+    constexpr TypeTable CHECKED_IF_ALIVE(SCROLLING_TYPES & ~EXIT_SCHEDULED_TYPES);
+
+    bool moves(unsigned char type, unsigned char flags)
+    {
+        return (MOVES_IF_ALIVE.bits[type] & flags) != 0;
+    }
+
+    bool checked(unsigned char type)
+    {
+        return CHECKED_IF_ALIVE.bits[type] != 0;
+    }
+
+    void advanceScalar(double *x, double *y, const double *horizSpeed, const double *vertSpeed, const unsigned char *types, unsigned char *flags,
+                       size_t begin, size_t end, double grVertSpeed)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!moves(types[i], flags[i]))
+            {
+                continue;
+            }
+            // actor's vert speed depends on ghost racer's vert speed
+            double newY = y[i] + (vertSpeed[i] - grVertSpeed);
+            double newX = x[i] + horizSpeed[i];
+            x[i] = newX;
+            y[i] = newY;
+
+            // set dead if offscreen
+            if (checked(types[i]) && ((newX < 0 || newX > VIEW_WIDTH) || (newY < 0 || newY > VIEW_HEIGHT)))
+            {
+                flags[i] &= ~ActorStore::ALIVE;
+            }
+        }
+    }
+
+#ifdef MOVEMENT_X86
+    __attribute__((target("sse2"))) void advanceSSE2(double *x, double *y, const double *horizSpeed, const double *vertSpeed, const unsigned char *types, unsigned char *flags,
+                                                      size_t begin, size_t end, double grVertSpeed)
+    {
+        const __m128d grSpeed = _mm_set1_pd(grVertSpeed);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d width = _mm_set1_pd(VIEW_WIDTH);
+        const __m128d height = _mm_set1_pd(VIEW_HEIGHT);
+        size_t i = begin;
+        for (; i + 2 <= end; i += 2)
+        {
+            long long moves0 = moves(types[i], flags[i]) ? -1 : 0;
+            long long moves1 = moves(types[i + 1], flags[i + 1]) ? -1 : 0;
+            if ((moves0 | moves1) == 0)
+            {
+                continue;
+            }
+            __m128d mask = _mm_castsi128_pd(_mm_set_epi64x(moves1, moves0));
+
+            __m128d oldX = _mm_loadu_pd(x + i);
+            __m128d oldY = _mm_loadu_pd(y + i);
+            __m128d newX = _mm_add_pd(oldX, _mm_loadu_pd(horizSpeed + i));
+            __m128d newY = _mm_add_pd(oldY, _mm_sub_pd(_mm_loadu_pd(vertSpeed + i), grSpeed));
+            // lanes that don't move keep their old bits exactly
+            newX = _mm_or_pd(_mm_and_pd(mask, newX), _mm_andnot_pd(mask, oldX));
+            newY = _mm_or_pd(_mm_and_pd(mask, newY), _mm_andnot_pd(mask, oldY));
+            _mm_storeu_pd(x + i, newX);
+            _mm_storeu_pd(y + i, newY);
+
+            __m128d off = _mm_or_pd(_mm_or_pd(_mm_cmplt_pd(newX, zero), _mm_cmpgt_pd(newX, width)),
+                                    _mm_or_pd(_mm_cmplt_pd(newY, zero), _mm_cmpgt_pd(newY, height)));
+            int offScreen = _mm_movemask_pd(_mm_and_pd(off, mask)) & (checked(types[i]) | checked(types[i + 1]) << 1);
+            if (offScreen & 1)
+                flags[i] &= ~ActorStore::ALIVE;
+            if (offScreen & 2)
+                flags[i + 1] &= ~ActorStore::ALIVE;
+        }
+        advanceScalar(x, y, horizSpeed, vertSpeed, types, flags, i, end, grVertSpeed);
+    }
+
+    __attribute__((target("avx2"))) void advanceAVX2(double *x, double *y, const double *horizSpeed, const double *vertSpeed, const unsigned char *types, unsigned char *flags,
+                                                      size_t begin, size_t end, double grVertSpeed)
+    {
+        const __m256d grSpeed = _mm256_set1_pd(grVertSpeed);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d width = _mm256_set1_pd(VIEW_WIDTH);
+        const __m256d height = _mm256_set1_pd(VIEW_HEIGHT);
+        const __m128i movesIfAlive = _mm_load_si128(reinterpret_cast<const __m128i *>(MOVES_IF_ALIVE.bits));
+        const __m128i checkedIfAlive = _mm_load_si128(reinterpret_cast<const __m128i *>(CHECKED_IF_ALIVE.bits));
+        const __m256i zeroLanes = _mm256_setzero_si256();
+        size_t i = begin;
+        for (; i + 4 <= end; i += 4)
+        {
+            // look 4 type bytes up in the move table, keep the ALIVE bit of
+            // the flag bytes, and widen the result to one 64-bit lane each
+            int packedTypes;
+            int packedFlags;
+            std::memcpy(&packedTypes, types + i, sizeof(packedTypes));
+            std::memcpy(&packedFlags, flags + i, sizeof(packedFlags));
+            __m128i typeBytes = _mm_cvtsi32_si128(packedTypes);
+            __m128i flagBytes = _mm_cvtsi32_si128(packedFlags);
+            __m128i moveBits = _mm_and_si128(_mm_shuffle_epi8(movesIfAlive, typeBytes), flagBytes);
+            __m256i laneBits = _mm256_cvtepu8_epi64(moveBits);
+            __m256d mask = _mm256_castsi256_pd(_mm256_xor_si256(_mm256_cmpeq_epi64(laneBits, zeroLanes), _mm256_set1_epi64x(-1)));
+            if (_mm256_testz_pd(mask, mask))
+            {
+                continue;
+            }
+            __m256i checkBits = _mm256_cvtepu8_epi64(_mm_and_si128(_mm_shuffle_epi8(checkedIfAlive, typeBytes), flagBytes));
+            __m256d checkMask = _mm256_castsi256_pd(_mm256_xor_si256(_mm256_cmpeq_epi64(checkBits, zeroLanes), _mm256_set1_epi64x(-1)));
+
+            __m256d oldX = _mm256_loadu_pd(x + i);
+            __m256d oldY = _mm256_loadu_pd(y + i);
+            __m256d newX = _mm256_add_pd(oldX, _mm256_loadu_pd(horizSpeed + i));
+            __m256d newY = _mm256_add_pd(oldY, _mm256_sub_pd(_mm256_loadu_pd(vertSpeed + i), grSpeed));
+            newX = _mm256_blendv_pd(oldX, newX, mask);
+            newY = _mm256_blendv_pd(oldY, newY, mask);
+            _mm256_storeu_pd(x + i, newX);
+            _mm256_storeu_pd(y + i, newY);
+
+            __m256d off = _mm256_or_pd(_mm256_or_pd(_mm256_cmp_pd(newX, zero, _CMP_LT_OQ), _mm256_cmp_pd(newX, width, _CMP_GT_OQ)),
+                                       _mm256_or_pd(_mm256_cmp_pd(newY, zero, _CMP_LT_OQ), _mm256_cmp_pd(newY, height, _CMP_GT_OQ)));
+            int offScreen = _mm256_movemask_pd(_mm256_and_pd(off, checkMask));
+            for (int lane = 0; offScreen != 0; ++lane, offScreen >>= 1)
+            {
+                if (offScreen & 1)
+                    flags[i + lane] &= ~ActorStore::ALIVE;
+            }
+        }
+        // GCC doesn't clear the upper halves on the way out of this function, and
+        // leaving them dirty makes later SSE code (libm's cos included) run many times slower
+        _mm256_zeroupper();
+        advanceScalar(x, y, horizSpeed, vertSpeed, types, flags, i, end, grVertSpeed);
+    }
+#endif // MOVEMENT_X86
+
+    typedef void (*AdvanceFunction)(double *, double *, const double *, const double *, const unsigned char *, unsigned char *, size_t, size_t, double);
+
+    AdvanceFunction functionFor(MovementKernel kernel)
+    {
+        switch (kernel)
+        {
+#ifdef MOVEMENT_X86
+        case MOVEMENT_KERNEL_SSE2:
+            return advanceSSE2;
+        case MOVEMENT_KERNEL_AVX2:
+            return advanceAVX2;
+#endif
+        default:
+            return advanceScalar;
+        }
+    }
+}
+
+void advanceScrolling(double *x, double *y, const double *horizSpeed, const double *vertSpeed, const unsigned char *types, unsigned char *flags,
+                      size_t begin, size_t end, double grVertSpeed)
+{
+    // chosen once, the first time anything moves
+    static const AdvanceFunction best = functionFor(bestMovementKernel());
+    best(x, y, horizSpeed, vertSpeed, types, flags, begin, end, grVertSpeed);
+}
+
+void advanceScrollingWith(MovementKernel kernel, double *x, double *y, const double *horizSpeed, const double *vertSpeed, const unsigned char *types, unsigned char *flags,
+                          size_t begin, size_t end, double grVertSpeed)
+{
+    functionFor(kernel)(x, y, horizSpeed, vertSpeed, types, flags, begin, end, grVertSpeed);
+}
+
+MovementKernel bestMovementKernel()
+{
+    if (isMovementKernelSupported(MOVEMENT_KERNEL_AVX2))
+    {
+        return MOVEMENT_KERNEL_AVX2;
+    }
+    if (isMovementKernelSupported(MOVEMENT_KERNEL_SSE2))
+    {
+        return MOVEMENT_KERNEL_SSE2;
+    }
+    return MOVEMENT_KERNEL_SCALAR;
+}
+
+bool isMovementKernelSupported(MovementKernel kernel)
+{
+    switch (kernel)
+    {
+    case MOVEMENT_KERNEL_SCALAR:
+        return true;
+#ifdef MOVEMENT_X86
+    case MOVEMENT_KERNEL_SSE2:
+        // this may run before libgcc's own constructor has filled in the
+        // feature bits (from another static initializer), so fill them in first
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+    case MOVEMENT_KERNEL_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+const char *movementKernelName(MovementKernel kernel)
+{
+    static const char *const NAMES[NUM_MOVEMENT_KERNELS] = {"scalar", "sse2", "avx2"};
+    return (kernel >= 0 && kernel < NUM_MOVEMENT_KERNELS) ? NAMES[kernel] : "unknown";
+}
@@ -0,0 +1,35 @@
+#ifndef MOVEMENTKERNEL_H_
+#define MOVEMENTKERNEL_H_
+
+#include <cstddef>
+
+// Moves every scrolling actor in one pass over the ActorStore arrays.
+// The widest variant the CPU supports is picked at runtime.
+
+enum MovementKernel
+{
+    MOVEMENT_KERNEL_SCALAR,
+    MOVEMENT_KERNEL_SSE2,
+    MOVEMENT_KERNEL_AVX2,
+    NUM_MOVEMENT_KERNELS
+};
+
+/*
+ * For every slot in [begin, end) that is ALIVE and of a scrolling type, add its horizontal
+ * speed to x and its vertical speed relative to the GR to y, then clear ALIVE
+ * if it ended up off screen. Same arithmetic as the old per-actor Actor::move.
+ * Types whose exit StudentWorld schedules (EXIT_SCHEDULED_TYPES) move but
+ * aren't checked.
+ */
+void advanceScrolling(double *x, double *y, const double *horizSpeed, const double *vertSpeed, const unsigned char *types, unsigned char *flags,
+                      size_t begin, size_t end, double grVertSpeed);
+
+// same, with a specific variant (for benchmarks); it must be supported
+void advanceScrollingWith(MovementKernel kernel, double *x, double *y, const double *horizSpeed, const double *vertSpeed, const unsigned char *types, unsigned char *flags,
+                          size_t begin, size_t end, double grVertSpeed);
+
+MovementKernel bestMovementKernel();
+bool isMovementKernelSupported(MovementKernel kernel);
+const char *movementKernelName(MovementKernel kernel);
+
+#endif // MOVEMENTKERNEL_H_
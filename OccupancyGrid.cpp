@@ -0,0 +1,121 @@
+#include "OccupancyGrid.h"
+#include "Actor.h"
+#include "ActorStore.h"
+#include "ProjectileRing.h"
+#include "GameConstants.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    // channel each actor type is drawn in; NUM_GRID_CHANNELS for types that aren't drawn
+    struct ChannelTable
+    {
+        unsigned char channel[NUM_ACTOR_TYPES];
+        constexpr ChannelTable() : channel()
+        {
+            for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+            {
+                channel[type] = NUM_GRID_CHANNELS;
+            }
+            channel[ACTOR_ZOMBIE_PED] = GRID_ZOMBIE;
+            channel[ACTOR_HUMAN_PED] = GRID_HUMAN;
+            channel[ACTOR_ZOMBIE_CAB] = GRID_CAB;
+            channel[ACTOR_SOUL] = GRID_GOODIE;
+            channel[ACTOR_HEAL_GOODIE] = GRID_GOODIE;
+            channel[ACTOR_WATER_GOODIE] = GRID_GOODIE;
+            channel[ACTOR_OIL_SLICK] = GRID_OIL;
+        }
+    };
+    constexpr ChannelTable CHANNELS;
+
+    // the 8 bytes, each 0 or 1, that the bits of a byte expand to
+    struct ByteExpansion
+    {
+        std::uint64_t bytes[256];
+        constexpr ByteExpansion() : bytes()
+        {
+            for (int bits = 0; bits < 256; ++bits)
+            {
+                for (int b = 0; b < 8; ++b)
+                {
+                    bytes[bits] |= static_cast<std::uint64_t>((bits >> b) & 1) << (8 * b);
+                }
+            }
+        }
+    };
+    constexpr ByteExpansion EXPANSION;
+
+    static_assert(GRID_SIZE == 32, "a grid row is kept as one 32-bit mask while splatting");
+
+    constexpr double CELLS_PER_X = static_cast<double>(GRID_SIZE) / VIEW_WIDTH;
+    constexpr double CELLS_PER_Y = static_cast<double>(GRID_SIZE) / VIEW_HEIGHT;
+
+    // cell a coordinate falls in, clamped to [-1, GRID_SIZE]
+    int cellOf(double v, double cellsPerUnit)
+    {
+        double cell = v * cellsPerUnit;
+        return (cell < 0) ? -1 : std::min(static_cast<int>(cell), GRID_SIZE);
+    }
+
+    /* OR the columns an actor's box covers into each row it covers; @param live false splats nothing */
+    void splatBox(std::uint32_t *layer, double x, double y, double radius, bool live)
+    {
+        // the box isOverlapping tests against, so a covered cell is one the actor can hit
+        double halfWidth = radius * Actor::X_SCALE;
+        double halfHeight = radius * Actor::Y_SCALE;
+        int col0 = std::max(cellOf(x - halfWidth, CELLS_PER_X), 0);
+        int col1 = std::min(cellOf(x + halfWidth, CELLS_PER_X), GRID_SIZE - 1);
+        int row0 = std::max(cellOf(y - halfHeight, CELLS_PER_Y), 0);
+        int row1 = std::min(cellOf(y + halfHeight, CELLS_PER_Y), GRID_SIZE - 1);
+
+        // columns col0..col1; all zero if the box misses the grid or the actor is dead
+        std::uint64_t valid = -static_cast<std::uint64_t>((col0 <= col1) & live);
+        std::uint32_t colBits = static_cast<std::uint32_t>(((1ull << (col1 + 1)) - (1ull << col0)) & valid);
+        for (int row = row0; row <= row1; ++row)
+        {
+            layer[row] |= colBits;
+        }
+    }
+}
+
+/*
+ * Splats into one 32-bit mask per (channel, row) first, so an actor's box is
+ * a single mask of its columns ORed into each row it covers, then expands
+ * the masks to bytes at the end.
+ */
+void rasterizeOccupancy(const ActorStore &store, const ProjectileRing &projectiles, unsigned char *grid)
+{
+    // one spare layer soaks up the types that aren't drawn
+    std::uint32_t rows[(NUM_GRID_CHANNELS + 1) * GRID_SIZE] = {};
+
+    const double *xs = store.xs();
+    const double *ys = store.ys();
+    const double *radii = store.radii();
+    const unsigned char *types = store.types();
+    const unsigned char *flags = store.flags();
+    size_t count = store.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        splatBox(rows + CHANNELS.channel[types[i]] * GRID_SIZE, xs[i], ys[i], radii[i], flags[i] & ActorStore::ALIVE);
+    }
+    for (size_t i = 0; i < projectiles.size(); ++i)
+    {
+        splatBox(rows + GRID_HOLY_WATER * GRID_SIZE, projectiles.x(i), projectiles.y(i), ProjectileRing::RADIUS, true);
+    }
+
+    // most rows are empty, and clearing them all at once is cheaper than expanding them
+    std::memset(grid, 0, GRID_CELLS);
+    for (int r = 0; r < NUM_GRID_CHANNELS * GRID_SIZE; ++r)
+    {
+        if (rows[r] == 0)
+        {
+            continue;
+        }
+        for (int b = 0; b < 4; ++b)
+        {
+            std::memcpy(grid + r * GRID_SIZE + 8 * b, &EXPANSION.bytes[(rows[r] >> (8 * b)) & 0xff], 8);
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#ifndef OCCUPANCYGRID_H_
+#define OCCUPANCYGRID_H_
+
+#include <cstddef>
+
+class ActorStore;
+class ProjectileRing;
+
+// A low-resolution picture of the screen for bots: one GRID_SIZE x GRID_SIZE
+// layer per kind of actor, each cell 1 where an actor's collision box covers
+// it and 0 elsewhere.
+
+enum GridChannel
+{
+    GRID_ZOMBIE, // zombie pedestrians
+    GRID_HUMAN,
+    GRID_CAB,
+    GRID_GOODIE, // souls, healing and holy water refills
+    GRID_OIL,
+    GRID_HOLY_WATER, // projectiles
+    NUM_GRID_CHANNELS
+};
+
+const int GRID_SIZE = 32;
+const size_t GRID_CELLS = static_cast<size_t>(NUM_GRID_CHANNELS) * GRID_SIZE * GRID_SIZE;
+
+/*
+ * Overwrite @param grid (GRID_CELLS bytes) with the live actors in
+ * @param store and the holy water in @param projectiles. Cell (channel, row, col) is at
+ * grid[(channel * GRID_SIZE + row) * GRID_SIZE + col]; row 0 is the bottom
+ * of the screen and col 0 the left. The GR and borders aren't drawn.
+ */
+void rasterizeOccupancy(const ActorStore &store, const ProjectileRing &projectiles, unsigned char *grid);
+
+#endif // OCCUPANCYGRID_H_
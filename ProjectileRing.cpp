@@ -0,0 +1,71 @@
+#include "ProjectileRing.h"
+#include "Trig.h"
+using namespace std;
+
+ProjectileRing::ProjectileRing() : m_head(0), m_count(0) {}
+
+bool ProjectileRing::push(double x, double y, int direction)
+{
+    if (m_count == CAPACITY)
+    {
+        return false;
+    }
+    size_t entry = at(m_count++);
+    m_x[entry] = m_fromX[entry] = x;
+    m_y[entry] = m_fromY[entry] = y;
+    m_direction[entry] = direction;
+    m_travel[entry] = 0;
+    return true;
+}
+
+/* The oldest just moves the head on; anything else closes the gap by shifting the newer ones back */
+void ProjectileRing::remove(size_t i)
+{
+    if (i == 0)
+    {
+        m_head = at(1);
+        --m_count;
+        return;
+    }
+    for (size_t k = i + 1; k < m_count; ++k)
+    {
+        size_t to = at(k - 1);
+        size_t from = at(k);
+        m_x[to] = m_x[from];
+        m_y[to] = m_y[from];
+        m_fromX[to] = m_fromX[from];
+        m_fromY[to] = m_fromY[from];
+        m_direction[to] = m_direction[from];
+        m_travel[to] = m_travel[from];
+    }
+    --m_count;
+}
+
+void ProjectileRing::clear()
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+bool ProjectileRing::advance(size_t i)
+{
+    size_t entry = at(i);
+    m_fromX[entry] = m_x[entry];
+    m_fromY[entry] = m_y[entry];
+    m_x[entry] += SPEED * cosDegrees(m_direction[entry]);
+    m_y[entry] += SPEED * sinDegrees(m_direction[entry]);
+    m_travel[entry] += SPEED;
+
+    bool offScreen = (m_x[entry] < 0 || m_x[entry] > VIEW_WIDTH) || (m_y[entry] < 0 || m_y[entry] > VIEW_HEIGHT);
+    return !offScreen && m_travel[entry] < MAX_TRAVEL_DIST;
+}
+
+/* The frame steps once per tick in flight, as a moveForward would */
+void ProjectileRing::sprite(size_t i, double &x, double &y, int &direction, unsigned int &animationNumber) const
+{
+    size_t entry = at(i);
+    x = m_x[entry];
+    y = m_y[entry];
+    direction = m_direction[entry];
+    animationNumber = static_cast<unsigned int>(m_travel[entry] / SPEED);
+}
@@ -0,0 +1,73 @@
+#ifndef PROJECTILERING_H_
+#define PROJECTILERING_H_
+
+#include "ActorStore.h"
+#include "ActorTraits.h"
+#include "GameConstants.h"
+#include "GraphObject.h"
+#include "GraphScene.h"
+#include <cstddef>
+
+// Holy water in flight. The GR sprays at most SPRAYS_PER_TICK a tick and a
+// spray is gone within MAX_TICKS_IN_FLIGHT ticks, so no more than CAPACITY
+// are ever in flight: they live in fixed arrays used as a ring, oldest first,
+// and spraying only fills in the next entry. StudentWorld::updateProjectiles
+// runs them in one loop, and the renderer draws them as one SpriteBatch.
+class ProjectileRing : public SpriteBatch
+{
+public:
+    static const ActorType TYPE = ACTOR_HOLY_WATER; // for its traits; projectiles never enter the store
+    static const int DAMAGE = 1;
+    static const int SPEED = SPRITE_HEIGHT; // pixels a tick
+    static constexpr double MAX_TRAVEL_DIST = 160.0;
+    static constexpr double RADIUS = actorTraits(TYPE).size * GraphObject::RADIUS_PER_UNIT;
+    static const int SPRAYS_PER_TICK = 1; // GhostRacer::applyUserInput sprays no more often
+    static const int MAX_TICKS_IN_FLIGHT = static_cast<int>(MAX_TRAVEL_DIST / SPEED);
+    static const size_t CAPACITY = SPRAYS_PER_TICK * MAX_TICKS_IN_FLIGHT;
+    static_assert(MAX_TICKS_IN_FLIGHT * SPEED == MAX_TRAVEL_DIST, "a projectile runs dry on the tick it has flown MAX_TRAVEL_DIST");
+
+    ProjectileRing();
+
+    // add a projectile at (x, y) flying towards @param direction; false if CAPACITY are already in flight
+    bool push(double x, double y, int direction);
+    // drop projectile @param i, keeping the rest in order
+    void remove(size_t i);
+    void clear();
+
+    // projectiles in flight; 0 is the oldest
+    size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+    double x(size_t i) const { return m_x[at(i)]; }
+    double y(size_t i) const { return m_y[at(i)]; }
+    // where projectile @param i was when last checked for hits
+    double fromX(size_t i) const { return m_fromX[at(i)]; }
+    double fromY(size_t i) const { return m_fromY[at(i)]; }
+    int direction(size_t i) const { return m_direction[at(i)]; }
+
+    // fly projectile @param i SPEED pixels on; false if that took it off screen or out of range
+    bool advance(size_t i);
+
+    // SpriteBatch
+    int imageID() const override { return IID_HOLY_WATER_PROJECTILE; }
+    double spriteSize() const override { return actorTraits(TYPE).size; }
+    size_t spriteCount() const override { return m_count; }
+    void sprite(size_t i, double &x, double &y, int &direction, unsigned int &animationNumber) const override;
+
+private:
+    double m_x[CAPACITY];
+    double m_y[CAPACITY];
+    double m_fromX[CAPACITY];
+    double m_fromY[CAPACITY];
+    int m_direction[CAPACITY];
+    int m_travel[CAPACITY];
+    size_t m_head;  // entry of the oldest projectile
+    size_t m_count;
+
+    size_t at(size_t i) const
+    {
+        size_t entry = m_head + i;
+        return (entry < CAPACITY) ? entry : entry - CAPACITY;
+    }
+};
+
+#endif // PROJECTILERING_H_
@@ -0,0 +1,80 @@
+#include "Random.h"
+#include <utility>
+using namespace std;
+
+namespace
+{
+    // round multipliers and key schedule constants from the Philox paper
+    const uint32_t PHILOX_M0 = 0xD2511F53;
+    const uint32_t PHILOX_M1 = 0xCD9E8D57;
+    const uint32_t PHILOX_W0 = 0x9E3779B9;
+    const uint32_t PHILOX_W1 = 0xBB67AE85;
+    const int PHILOX_ROUNDS = 10;
+
+    void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo)
+    {
+        uint64_t product = static_cast<uint64_t>(a) * b;
+        hi = static_cast<uint32_t>(product >> 32);
+        lo = static_cast<uint32_t>(product);
+    }
+}
+
+PhiloxBlock philox4x32(PhiloxBlock counter, uint64_t key)
+{
+    uint32_t k0 = static_cast<uint32_t>(key);
+    uint32_t k1 = static_cast<uint32_t>(key >> 32);
+    uint32_t *x = counter.word;
+    for (int round = 0; round < PHILOX_ROUNDS; ++round)
+    {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(PHILOX_M0, x[0], hi0, lo0);
+        mulhilo(PHILOX_M1, x[2], hi1, lo1);
+        uint32_t next[4] = {hi1 ^ x[1] ^ k0, lo1, hi0 ^ x[3] ^ k1, lo0};
+        x[0] = next[0];
+        x[1] = next[1];
+        x[2] = next[2];
+        x[3] = next[3];
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    return counter;
+}
+
+int uniformInt(uint32_t bits, int min, int max)
+{
+    if (max < min)
+    {
+        swap(max, min);
+    }
+    // multiply-shift instead of modulo: no division, and no extra draws
+    uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    return static_cast<int>(min + static_cast<int64_t>((bits * span) >> 32));
+}
+
+int RandomStream::randInt(uint64_t seed, uint32_t tick, int min, int max)
+{
+    return uniformInt(nextBits(seed, tick), min, max);
+}
+
+double RandomStream::uniform(uint64_t seed, uint32_t tick)
+{
+    return (nextBits(seed, tick) + 1.0) * (1.0 / 4294967296.0);
+}
+
+uint32_t RandomStream::nextBits(uint64_t seed, uint32_t tick)
+{
+    if (tick != m_tick)
+    {
+        m_tick = tick;
+        m_draw = 0;
+    }
+    // one block serves four consecutive draws; the first of them computes it
+    // (a new tick restarts at draw 0, so a kept block is always this tick's)
+    if ((m_draw & 3) == 0 || seed != m_blockSeed)
+    {
+        PhiloxBlock counter = {{static_cast<uint32_t>(m_entity), static_cast<uint32_t>(m_entity >> 32), tick, m_draw >> 2}};
+        m_block = philox4x32(counter, seed);
+        m_blockSeed = seed;
+    }
+    return m_block.word[m_draw++ & 3];
+}
@@ -0,0 +1,48 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <cstdint>
+
+// Counter-based random numbers (Philox4x32-10, Salmon et al. 2011). A draw is
+// a pure function of (world seed, entity, tick, draw index), so any entity can
+// draw on any thread, in any order relative to the others, and a seeded game
+// replays exactly.
+
+struct PhiloxBlock
+{
+    std::uint32_t word[4];
+};
+
+// the raw generator: 10 rounds over a 128-bit counter under a 64-bit key
+PhiloxBlock philox4x32(PhiloxBlock counter, std::uint64_t key);
+
+// map 32 random bits onto [min, max]; the bias is below 2^-24 for the ranges the game uses
+int uniformInt(std::uint32_t bits, int min, int max);
+
+// One entity's stream. The draw index restarts every tick, so which values an
+// entity gets never depends on how many draws anything else made.
+class RandomStream
+{
+public:
+    explicit RandomStream(std::uint64_t entity = 0)
+        : m_entity(entity), m_tick(0), m_draw(0), m_blockSeed(0), m_block() {}
+
+    std::uint64_t entity() const { return m_entity; }
+
+    // uniform in [min, max], either order, like the old randInt
+    int randInt(std::uint64_t seed, std::uint32_t tick, int min, int max);
+    // uniform in (0, 1], so its log is finite
+    double uniform(std::uint64_t seed, std::uint32_t tick);
+
+private:
+    std::uint64_t m_entity;
+    std::uint32_t m_tick;
+    std::uint32_t m_draw;
+    // the block draws m_draw & ~3 .. m_draw | 3 of this tick come from, under m_blockSeed
+    std::uint64_t m_blockSeed;
+    PhiloxBlock m_block;
+
+    std::uint32_t nextBits(std::uint64_t seed, std::uint32_t tick);
+};
+
+#endif // RANDOM_H_
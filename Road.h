@@ -0,0 +1,71 @@
+#ifndef ROAD_H_
+#define ROAD_H_
+
+#include "GameConstants.h"
+#include <algorithm>
+
+// lanes on the road; build with e.g. DEFINES=-DROAD_LANES=5 for a wide-road scenario.
+// 1 to 5 lanes fit: each is ROAD_WIDTH / 3 (50) pixels wide and the screen is VIEW_WIDTH (256)
+#ifndef ROAD_LANES
+#define ROAD_LANES 3
+#endif
+
+// A road of Lanes equal-width lanes side by side. Lane i covers x in
+// [edge(i), edge(i + 1)); yellow lines run along the two outer edges and
+// white lines along the ones between lanes. Everything that needs lane
+// geometry (borders, spawning, cab AI) reads it from here.
+template <int Lanes>
+class RoadLayout
+{
+public:
+    static_assert(Lanes >= 1, "a road needs a lane");
+    static const int NUM_LANES = Lanes;
+
+    constexpr RoadLayout(double center, double laneWidth)
+        : m_edges(), m_laneWidth(laneWidth), m_inverseWidth(1 / laneWidth)
+    {
+        for (int i = 0; i <= Lanes; ++i)
+        {
+            m_edges[i] = center + (i - Lanes / 2.0) * laneWidth;
+        }
+    }
+
+    // i = 0 is the left edge of the road, i = NUM_LANES the right
+    constexpr double edge(int i) const { return m_edges[i]; }
+    constexpr double leftEdge() const { return m_edges[0]; }
+    constexpr double rightEdge() const { return m_edges[Lanes]; }
+    constexpr double laneWidth() const { return m_laneWidth; }
+    constexpr double center(int lane) const { return m_edges[lane] + m_laneWidth / 2; }
+
+    /*
+     * Lane that @param x is in, or -1 off the road. One multiply guesses the
+     * lane and a compare against each neighbouring edge corrects rounding, so
+     * it costs the same for any number of lanes and has no data-dependent
+     * branches.
+     */
+    int laneAt(double x) const
+    {
+        // actor positions are never within many orders of magnitude of long long's range
+        long long guess = static_cast<long long>((x - m_edges[0]) * m_inverseWidth);
+        guess = std::min(std::max(guess, 0LL), static_cast<long long>(Lanes - 1));
+        int lane = static_cast<int>(guess);
+        lane += (x >= m_edges[lane + 1]) - (x < m_edges[lane]);
+        // all ones on the road, zero off it
+        int onRoad = -static_cast<int>((x >= m_edges[0]) & (x < m_edges[Lanes]));
+        return (lane & onRoad) | ~onRoad;
+    }
+
+private:
+    double m_edges[Lanes + 1];
+    double m_laneWidth;
+    double m_inverseWidth;
+};
+
+typedef RoadLayout<ROAD_LANES> Road;
+
+// The game's road: lanes as wide as the original three-lane road's, centred
+// on the screen; the three-lane build matches ROAD_WIDTH exactly
+static_assert(ROAD_LANES * (ROAD_WIDTH / 3) <= VIEW_WIDTH, "ROAD_LANES lanes don't fit on the screen");
+constexpr Road ROAD(ROAD_CENTER, ROAD_WIDTH / 3);
+
+#endif // ROAD_H_
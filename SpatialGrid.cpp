@@ -0,0 +1,166 @@
+#include "SpatialGrid.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+SpatialGrid::SpatialGrid()
+{
+    memset(m_bucketStart, 0, sizeof(m_bucketStart));
+    memset(m_typeCount, 0, sizeof(m_typeCount));
+}
+
+/* Counting sort of the matching slots by bucket: count per bucket, prefix sum, then scatter in slot order */
+void SpatialGrid::rebuild(const ActorStore &store, size_t begin, ActorTypeMask types)
+{
+    const unsigned char *storeTypes = store.types();
+    const unsigned char *flags = store.flags();
+    const double *xs = store.xs();
+    const double *ys = store.ys();
+
+    // the counts become each bucket's next free index once they're summed
+    vector<uint32_t> &counts = m_countScratch;
+    counts.assign(NUM_BUCKETS, 0);
+    m_bucketOf.clear();
+    m_pending.clear();
+    for (size_t slot = begin; slot < store.size(); ++slot)
+    {
+        if ((flags[slot] & ActorStore::ALIVE) && isTypeIn(types, storeTypes[slot]))
+        {
+            uint32_t bucket = storeTypes[slot] * NUM_CELLS + rowOf(ys[slot]) * COLUMNS + columnOf(xs[slot]);
+            m_bucketOf.push_back(bucket);
+            m_pending.push_back(static_cast<uint32_t>(slot));
+            ++counts[bucket];
+        }
+    }
+
+    m_bucketStart[0] = 0;
+    for (int bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+    {
+        m_bucketStart[bucket + 1] = m_bucketStart[bucket] + counts[bucket];
+        counts[bucket] = m_bucketStart[bucket];
+    }
+    for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+    {
+        m_typeCount[type] = m_bucketStart[(type + 1) * NUM_CELLS] - m_bucketStart[type * NUM_CELLS];
+    }
+
+    size_t count = m_pending.size();
+    m_slots.resize(count);
+    m_x.resize(count);
+    m_y.resize(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        uint32_t slot = m_pending[k];
+        uint32_t at = counts[m_bucketOf[k]]++;
+        m_slots[at] = slot;
+        m_x[at] = xs[slot];
+        m_y[at] = ys[slot];
+    }
+}
+
+/*
+ * Cells are read in square rings around the one holding (x, y). Nothing in a
+ * ring is nearer than the gap from (x, y) to its inner edge, so the search
+ * stops at the first ring whose gap reaches the k-th best distance so far (or
+ * the radius, until k are found), and skips cells in a ring that are already
+ * that far away. Edge cells also hold the actors beyond the screen, but those
+ * are farther still, so the gaps stay lower bounds.
+ */
+int SpatialGrid::nearestInRadius(double x, double y, double radius, ActorTypeMask types, size_t exclude, int k, Neighbour *out) const
+{
+    int typeBuckets[NUM_ACTOR_TYPES];
+    int numTypes = 0;
+    for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+    {
+        if (isTypeIn(types, type) && m_typeCount[type] != 0)
+        {
+            typeBuckets[numTypes++] = type * NUM_CELLS;
+        }
+    }
+    if (numTypes == 0 || k <= 0)
+    {
+        return 0;
+    }
+
+    const double *xs = m_x.data();
+    const double *ys = m_y.data();
+    const uint32_t *slots = m_slots.data();
+    int found = 0;
+    int farthest = 0; // which of out is farthest, once found == k
+    // a candidate must be nearer than this: the radius, then the farthest of k kept
+    double limitSq = radius * radius;
+    int column = columnOf(x);
+    int row = rowOf(y);
+    for (int ring = 0;; ++ring)
+    {
+        if (ring > 0)
+        {
+            // gap to the nearest side of this ring that's on the grid
+            double gap = HUGE_VAL;
+            if (column - ring >= 0)
+            {
+                gap = min(gap, x - (column - ring + 1) * CELL_SIZE);
+            }
+            if (column + ring < COLUMNS)
+            {
+                gap = min(gap, (column + ring) * CELL_SIZE - x);
+            }
+            if (row - ring >= 0)
+            {
+                gap = min(gap, y - (row - ring + 1) * CELL_SIZE);
+            }
+            if (row + ring < ROWS)
+            {
+                gap = min(gap, (row + ring) * CELL_SIZE - y);
+            }
+            if (gap * gap >= limitSq)
+            {
+                return found;
+            }
+        }
+
+        for (int r = max(row - ring, 0); r <= min(row + ring, ROWS - 1); ++r)
+        {
+            double gapY = (r > row) ? r * CELL_SIZE - y : ((r < row) ? y - (r + 1) * CELL_SIZE : 0);
+            // the ring's top and bottom rows are whole; the rows between only have their ends
+            int step = (abs(r - row) == ring) ? 1 : 2 * ring;
+            for (int c = column - ring; c <= column + ring; c += step)
+            {
+                double gapX = (c > column) ? c * CELL_SIZE - x : ((c < column) ? x - (c + 1) * CELL_SIZE : 0);
+                if (c < 0 || c >= COLUMNS || gapX * gapX + gapY * gapY >= limitSq)
+                {
+                    continue;
+                }
+                for (int t = 0; t < numTypes; ++t)
+                {
+                    int bucket = typeBuckets[t] + r * COLUMNS + c;
+                    for (uint32_t i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i)
+                    {
+                        double dx = xs[i] - x;
+                        double dy = ys[i] - y;
+                        double distanceSq = dx * dx + dy * dy;
+                        if (distanceSq >= limitSq || slots[i] == exclude)
+                        {
+                            continue;
+                        }
+                        int keep = (found < k) ? found++ : farthest;
+                        out[keep] = Neighbour{slots[i], dx, dy, distanceSq};
+                        if (found == k)
+                        {
+                            farthest = 0;
+                            for (int n = 1; n < k; ++n)
+                            {
+                                if (out[n].distanceSq > out[farthest].distanceSq)
+                                {
+                                    farthest = n;
+                                }
+                            }
+                            limitSq = out[farthest].distanceSq;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
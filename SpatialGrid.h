@@ -0,0 +1,155 @@
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#include "ActorStore.h"
+#include "ActorTraits.h"
+#include "GameConstants.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Broadphase for "what's near here": live actors bucketed by type and
+// position into a uniform grid over the screen, rebuilt once a tick by a
+// counting sort of the store, so a query reads a few cells of just the types
+// it asks for instead of every slot. Actors off screen go in the nearest edge
+// cell and queries clamp the same way, so nothing is missed. Positions are
+// copied in bucket order, which keeps a query on contiguous memory, and
+// within a bucket actors stay in slot order, so results don't depend on
+// threads.
+class SpatialGrid
+{
+public:
+    static const int CELL_SIZE = 16;
+    static const int COLUMNS = VIEW_WIDTH / CELL_SIZE;
+    static const int ROWS = VIEW_HEIGHT / CELL_SIZE;
+    static const int NUM_CELLS = COLUMNS * ROWS;
+
+    SpatialGrid();
+
+    // index the live actors in store slots [begin, size) of the types in @param types
+    void rebuild(const ActorStore &store, size_t begin, ActorTypeMask types);
+    size_t size() const { return m_slots.size(); }
+
+    /*
+     * Call f(slot, dx, dy) for every indexed actor of a type in @param types
+     * closer than @param radius to (x, y), where (dx, dy) is its offset from
+     * (x, y). The cell holding (x, y) is visited first; f returns false to
+     * stop the query, so a capped neighbour search mostly reads one cell.
+     */
+    template <typename F>
+    void forEachInRadius(double x, double y, double radius, ActorTypeMask types, F &&f) const
+    {
+        const double radiusSq = radius * radius;
+        // the first bucket of each type asked for, so a cell visit skips the rest
+        int typeBuckets[NUM_ACTOR_TYPES];
+        int numTypes = 0;
+        for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+        {
+            if (isTypeIn(types, type) && m_typeCount[type] != 0)
+            {
+                typeBuckets[numTypes++] = type * NUM_CELLS;
+            }
+        }
+        if (numTypes == 0)
+        {
+            return;
+        }
+
+        auto visitCell = [&](int cell) {
+            for (int t = 0; t < numTypes; ++t)
+            {
+                int bucket = typeBuckets[t] + cell;
+                for (std::uint32_t k = m_bucketStart[bucket]; k < m_bucketStart[bucket + 1]; ++k)
+                {
+                    double dx = m_x[k] - x;
+                    double dy = m_y[k] - y;
+                    if (dx * dx + dy * dy < radiusSq && !f(static_cast<size_t>(m_slots[k]), dx, dy))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        };
+
+        int column = columnOf(x);
+        int row = rowOf(y);
+        if (!visitCell(row * COLUMNS + column))
+        {
+            return;
+        }
+        int firstColumn = columnOf(x - radius), lastColumn = columnOf(x + radius);
+        int firstRow = rowOf(y - radius), lastRow = rowOf(y + radius);
+        for (int r = firstRow; r <= lastRow; ++r)
+        {
+            for (int c = firstColumn; c <= lastColumn; ++c)
+            {
+                if ((r != row || c != column) && !visitCell(r * COLUMNS + c))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    struct Neighbour
+    {
+        size_t slot;
+        double dx, dy;     // offset from the query point
+        double distanceSq;
+    };
+
+    /*
+     * The up to @param k indexed actors of a type in @param types nearest to
+     * (x, y) and closer than @param radius, other than slot @param exclude,
+     * written to @param out in no particular order; returns how many. Reads
+     * cells outward from (x, y) only until none left can hold anything closer.
+     */
+    int nearestInRadius(double x, double y, double radius, ActorTypeMask types, size_t exclude, int k, Neighbour *out) const;
+
+    // call f(slot, x, y) for every indexed actor of a type in @param types positioned inside the box
+    template <typename F>
+    void forEachInBox(double left, double bottom, double right, double top, ActorTypeMask types, F &&f) const
+    {
+        int firstColumn = columnOf(left), lastColumn = columnOf(right);
+        int firstRow = rowOf(bottom), lastRow = rowOf(top);
+        for (int type = 0; type < NUM_ACTOR_TYPES; ++type)
+        {
+            if (!isTypeIn(types, type) || m_typeCount[type] == 0)
+            {
+                continue;
+            }
+            for (int r = firstRow; r <= lastRow; ++r)
+            {
+                // a row's cells are adjacent buckets, so this is one run of the arrays
+                int bucket = type * NUM_CELLS + r * COLUMNS;
+                for (std::uint32_t k = m_bucketStart[bucket + firstColumn]; k < m_bucketStart[bucket + lastColumn + 1]; ++k)
+                {
+                    if (m_x[k] >= left && m_x[k] <= right && m_y[k] >= bottom && m_y[k] <= top)
+                    {
+                        f(static_cast<size_t>(m_slots[k]), m_x[k], m_y[k]);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    // one bucket per (type, cell): bucket b's actors are at m_bucketStart[b] ..
+    // m_bucketStart[b + 1] in the arrays below
+    static const int NUM_BUCKETS = NUM_ACTOR_TYPES * NUM_CELLS;
+    std::uint32_t m_bucketStart[NUM_BUCKETS + 1];
+    std::uint32_t m_typeCount[NUM_ACTOR_TYPES];
+    std::vector<std::uint32_t> m_slots;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<std::uint32_t> m_bucketOf; // scratch: each indexed slot's bucket, in slot order
+    std::vector<std::uint32_t> m_pending;  // scratch: the slots m_bucketOf is for
+    std::vector<std::uint32_t> m_countScratch;
+
+    static int columnOf(double x) { return std::min(std::max(static_cast<int>(x / CELL_SIZE), 0), COLUMNS - 1); }
+    static int rowOf(double y) { return std::min(std::max(static_cast<int>(y / CELL_SIZE), 0), ROWS - 1); }
+};
+
+#endif // SPATIALGRID_H_
@@ -12,11 +12,13 @@
 #endif
 
 #include "GameConstants.h"
+#include "Trig.h"
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <map>
 #include <memory>
+#include <vector>
 
 class SpriteManager
 {
@@ -146,11 +148,6 @@ public:
 
 		glPushMatrix();
 
-		double finalWidth, finalHeight;
-
-		finalWidth = SPRITE_WIDTH_GL * size;
-		finalHeight = SPRITE_HEIGHT_GL * size;
-
 		// object's x/y location is center-based, but sprite plotting is upper-left-corner based
 		const double xoffset = 0;// finalWidth / 2;
 		const double yoffset = 0;// finalHeight / 2;
@@ -173,45 +170,19 @@ public:
 		cx3 = 1; cy3 = 1;
 		cx4 = 0; cy4 = 1;
 
-		double rx1, ry1, rx2, ry2, rx3, ry3, rx4, ry4;
-
-//#define FULL_ROTATION	// for games where you can rotate 360 degrees, not just n/s/e/w
-
-#ifndef FULL_ROTATION
-		if (angleDegrees != 180)
-		{
-			rotate(-finalWidth / 2, -finalHeight / 2, angleDegrees, rx1, ry1);
-			rotate(finalWidth / 2, -finalHeight / 2, angleDegrees, rx2, ry2);
-			rotate(finalWidth / 2, finalHeight / 2, angleDegrees, rx3, ry3);
-			rotate(-finalWidth / 2, finalHeight / 2, angleDegrees, rx4, ry4);
-		}
-		else
-		{
-			// Ensure actors rotated to face left aren't upside-down.
-			rotate(-finalWidth / 2, -finalHeight / 2, 0, rx1, ry1);
-			rotate(finalWidth / 2, -finalHeight / 2, 0, rx2, ry2);
-			rotate(finalWidth / 2, finalHeight / 2, 0, rx3, ry3);
-			rotate(-finalWidth / 2, finalHeight / 2, 0, rx4, ry4);
-			std::swap(rx1, rx2);
-			std::swap(rx3, rx4);
-		}
-#else
-		angleDegrees += 90;
-		rotate(-finalWidth / 2, -finalHeight / 2, angleDegrees, rx1, ry1);
-		rotate(finalWidth / 2, -finalHeight / 2, angleDegrees, rx2, ry2);
-		rotate(finalWidth / 2, finalHeight / 2, angleDegrees, rx3, ry3);
-		rotate(-finalWidth / 2, finalHeight / 2, angleDegrees, rx4, ry4);
-#endif  // FULL_ROTATION
+		const QuadCorners& corners = cachedCorners(angleDegrees, size);
+		const double* rx = corners.rx;
+		const double* ry = corners.ry;
 
 		glBegin(GL_QUADS);
 		glTexCoord2d(cx1, cy1);
-		glVertex3f(static_cast<GLfloat>(rx1), static_cast<GLfloat>(ry1), 0);
+		glVertex3f(static_cast<GLfloat>(rx[0]), static_cast<GLfloat>(ry[0]), 0);
 		glTexCoord2d(cx2, cy2);
-		glVertex3f(static_cast<GLfloat>(rx2), static_cast<GLfloat>(ry2), 0);
+		glVertex3f(static_cast<GLfloat>(rx[1]), static_cast<GLfloat>(ry[1]), 0);
 		glTexCoord2d(cx3, cy3);
-		glVertex3f(static_cast<GLfloat>(rx3), static_cast<GLfloat>(ry3), 0);
+		glVertex3f(static_cast<GLfloat>(rx[2]), static_cast<GLfloat>(ry[2]), 0);
 		glTexCoord2d(cx4, cy4);
-		glVertex3f(static_cast<GLfloat>(rx4), static_cast<GLfloat>(ry4), 0);
+		glVertex3f(static_cast<GLfloat>(rx[3]), static_cast<GLfloat>(ry[3]), 0);
 		glEnd();
 
 
@@ -237,6 +208,71 @@ public:
 		return true;
 	}
 
+	struct BatchSprite
+	{
+		double gx, gy, gz;
+		int angleDegrees;
+		unsigned int frame;	// already wrapped to the image's frame count
+	};
+
+	  // Plot @param count sprites of one image and size as plotSprite would, but
+	  // under one set of GL state and with one glBegin per frame texture rather
+	  // than a matrix push, attribute push and texture bind per sprite
+	bool plotSpriteBatch(int imageID, const BatchSprite* sprites, size_t count, double size)
+	{
+		if (count == 0)
+			return true;
+
+		glPushAttrib(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glEnable(GL_TEXTURE_2D);
+		glDisable(GL_DEPTH_TEST);
+		glEnable (GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glColor3f(1.0, 1.0, 1.0);
+
+		bool plottedAll = true;
+		unsigned int numFrames = getNumFrames(imageID);
+		for (unsigned int frame = 0; frame < numFrames; frame++)
+		{
+			auto it = m_imageMap.find(getSpriteID(imageID, frame));
+			if (it == m_imageMap.end())
+			{
+				plottedAll = false;
+				continue;
+			}
+			bool bound = false;
+			for (size_t i = 0; i < count; i++)
+			{
+				const BatchSprite& sprite = sprites[i];
+				if (sprite.frame != frame)
+					continue;
+				if (!bound)
+				{
+					glBindTexture(GL_TEXTURE_2D, it->second);
+					glBegin(GL_QUADS);
+					bound = true;
+				}
+
+				const QuadCorners& corners = cachedCorners(sprite.angleDegrees, size);
+				static const double cx[4] = { 0, 1, 1, 0 };
+				static const double cy[4] = { 0, 0, 1, 1 };
+				for (int c = 0; c < 4; c++)
+				{
+					glTexCoord2d(cx[c], cy[c]);
+					glVertex3f(static_cast<GLfloat>(sprite.gx + corners.rx[c]), static_cast<GLfloat>(sprite.gy + corners.ry[c]), static_cast<GLfloat>(sprite.gz));
+				}
+			}
+			if (bound)
+				glEnd();
+		}
+
+		glDisable(GL_TEXTURE_2D);
+		glEnable(GL_DEPTH_TEST);
+		glPopAttrib();
+
+		return plottedAll;
+	}
+
 	~SpriteManager()
 	{
 		for (auto it = m_imageMap.begin(); it != m_imageMap.end(); it++)
@@ -245,16 +281,78 @@ public:
 
 private:
 
-	void rotate(double x, double y, double degrees, double &xout, double &yout)
+	struct QuadCorners
+	{
+		double size;
+		double rx[4], ry[4];
+	};
+
+	  // spriteCorners, remembered: one entry per size drawn at each angle.
+	  // A game draws a handful of sizes, so a lookup is a short scan.
+	const QuadCorners& cachedCorners(int angleDegrees, double size)
+	{
+		angleDegrees = TrigTable::wrap(angleDegrees);
+		std::vector<QuadCorners>& atAngle = m_cornerCache[angleDegrees];
+		for (const QuadCorners& corners : atAngle)
+		{
+			if (corners.size == size)
+				return corners;
+		}
+		QuadCorners corners;
+		corners.size = size;
+		spriteCorners(angleDegrees, size, corners.rx, corners.ry);
+		atAngle.push_back(corners);
+		return atAngle.back();
+	}
+
+	  // corners of a sprite of @param size facing @param angleDegrees, relative
+	  // to its centre, in the order plotSprite's texture coordinates expect
+	void spriteCorners(int angleDegrees, double size, double rx[4], double ry[4])
+	{
+		double finalWidth = SPRITE_WIDTH_GL * size;
+		double finalHeight = SPRITE_HEIGHT_GL * size;
+
+//#define FULL_ROTATION	// for games where you can rotate 360 degrees, not just n/s/e/w
+
+#ifndef FULL_ROTATION
+		if (angleDegrees != 180)
+		{
+			rotate(-finalWidth / 2, -finalHeight / 2, angleDegrees, rx[0], ry[0]);
+			rotate(finalWidth / 2, -finalHeight / 2, angleDegrees, rx[1], ry[1]);
+			rotate(finalWidth / 2, finalHeight / 2, angleDegrees, rx[2], ry[2]);
+			rotate(-finalWidth / 2, finalHeight / 2, angleDegrees, rx[3], ry[3]);
+		}
+		else
+		{
+			// Ensure actors rotated to face left aren't upside-down.
+			rotate(-finalWidth / 2, -finalHeight / 2, 0, rx[0], ry[0]);
+			rotate(finalWidth / 2, -finalHeight / 2, 0, rx[1], ry[1]);
+			rotate(finalWidth / 2, finalHeight / 2, 0, rx[2], ry[2]);
+			rotate(-finalWidth / 2, finalHeight / 2, 0, rx[3], ry[3]);
+			std::swap(rx[0], rx[1]);
+			std::swap(rx[2], rx[3]);
+		}
+#else
+		angleDegrees += 90;
+		rotate(-finalWidth / 2, -finalHeight / 2, angleDegrees, rx[0], ry[0]);
+		rotate(finalWidth / 2, -finalHeight / 2, angleDegrees, rx[1], ry[1]);
+		rotate(finalWidth / 2, finalHeight / 2, angleDegrees, rx[2], ry[2]);
+		rotate(-finalWidth / 2, finalHeight / 2, angleDegrees, rx[3], ry[3]);
+#endif  // FULL_ROTATION
+	}
+
+	void rotate(double x, double y, int degrees, double &xout, double &yout)
 	{
-		double theta = degrees*1.0 / 360 * 2 * 3.14159;
-		xout = x * cos(theta) - y * sin(theta);
-		yout = y * cos(theta) + x * sin(theta);
+		double c = cosDegrees(degrees);
+		double s = sinDegrees(degrees);
+		xout = x * c - y * s;
+		yout = y * c + x * s;
 	}
 
 	bool							m_mipMapped;
 	std::map<unsigned int, GLuint>	m_imageMap;
 	std::map<unsigned int, unsigned int>		m_frameCountPerSprite;
+	std::vector<QuadCorners>		m_cornerCache[360];	// by angle in [0, 360)
 
 	static const int INVALID_SPRITE_ID = -1;
 	static const int MAX_IMAGES = 1000;
@@ -0,0 +1,71 @@
+#include "StatusLine.h"
+#include <charconv>
+#include <cstring>
+using namespace std;
+
+namespace
+{
+    // labels include the padding the old setw() manipulators produced
+    const char *const LABELS[StatusLine::NUM_FIELDS] = {
+        "Score: ", "  Lvl: ", "  Souls2Save: ", "  Lives: ", "  Health: ", "  Sprays: ", "  Bonus: "};
+}
+
+/* Lay out every label with a value of 0 */
+StatusLine::StatusLine()
+    : m_length(0), m_changed(true)
+{
+    for (int i = 0; i < NUM_FIELDS; ++i)
+    {
+        size_t labelLength = strlen(LABELS[i]);
+        memcpy(m_text + m_length, LABELS[i], labelLength);
+        m_length += labelLength;
+
+        m_values[i] = 0;
+        m_valueStart[i] = m_length;
+        m_valueLength[i] = 1;
+        m_text[m_length++] = '0';
+    }
+    m_text[m_length] = '\0';
+}
+
+/* Set @param field to @param value, rewriting only its digits */
+void StatusLine::set(Field field, int value)
+{
+    if (m_values[field] == value)
+    {
+        return;
+    }
+    m_values[field] = value;
+    m_changed = true;
+
+    char digits[MAX_DIGITS];
+    int newLength = to_chars(digits, digits + MAX_DIGITS, value).ptr - digits;
+    int start = m_valueStart[field];
+    int shift = newLength - m_valueLength[field];
+
+    // different width, so slide everything after this field over
+    if (shift != 0)
+    {
+        int tailStart = start + m_valueLength[field];
+        memmove(m_text + tailStart + shift, m_text + tailStart, m_length - tailStart + 1); // +1 keeps the '\0'
+        m_length += shift;
+        m_valueLength[field] = newLength;
+        for (int i = field + 1; i < NUM_FIELDS; ++i)
+        {
+            m_valueStart[i] += shift;
+        }
+    }
+    memcpy(m_text + start, digits, newLength);
+}
+
+bool StatusLine::takeChanged()
+{
+    bool changed = m_changed;
+    m_changed = false;
+    return changed;
+}
+
+string_view StatusLine::text() const
+{
+    return string_view(m_text, m_length);
+}
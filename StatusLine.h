@@ -0,0 +1,46 @@
+#ifndef STATUSLINE_H_
+#define STATUSLINE_H_
+
+#include <string_view>
+
+// Fixed-buffer HUD line. Each field is a constant label followed by an int;
+// setting a field only re-renders that field's digits, so an unchanged line
+// costs a handful of compares and never allocates.
+class StatusLine
+{
+public:
+    enum Field
+    {
+        SCORE,
+        LEVEL,
+        SOULS,
+        LIVES,
+        HEALTH,
+        SPRAYS,
+        BONUS,
+        NUM_FIELDS
+    };
+
+    StatusLine();
+
+    void set(Field field, int value);
+
+    // returns true once after any field changed, then resets
+    bool takeChanged();
+
+    // view of the formatted line; always null terminated
+    std::string_view text() const;
+
+private:
+    static const int MAX_DIGITS = 11; // "-2147483648"
+    static const int MAX_LENGTH = 160; // labels plus NUM_FIELDS * MAX_DIGITS
+
+    char m_text[MAX_LENGTH];
+    int m_length;
+    int m_values[NUM_FIELDS];
+    int m_valueStart[NUM_FIELDS];
+    int m_valueLength[NUM_FIELDS];
+    bool m_changed;
+};
+
+#endif // STATUSLINE_H_
@@ -1,23 +1,57 @@
 #include "StudentWorld.h"
 #include "GameConstants.h"
+#include "AllocTracker.h"
+#include "Collision.h"
+#include "MovementKernel.h"
 #include <string>
+#include <cstdlib>
+#include <type_traits>
+#include <random>
 
 #include <iostream>
-#include <sstream>
-#include <iomanip>
-#include <set>
 #include <cmath>
+#include <algorithm>
 using namespace std;
 
+namespace
+{
+    // heap order for the spawn queue: earliest tick on top, ties in spawner order
+    template <typename Event>
+    bool laterSpawn(const Event &a, const Event &b)
+    {
+        return a.tick != b.tick ? a.tick > b.tick : a.spawner > b.spawner;
+    }
+}
+
 GameWorld *createStudentWorld(string assetPath)
 {
     return new StudentWorld(assetPath);
 }
 
+GameWorld *createHordeWorld(string assetPath)
+{
+    StudentWorld *world = new StudentWorld(assetPath);
+    world->setHordeMode(true);
+    return world;
+}
+
 /* Initialize stats and assets from @param assetPath */
 StudentWorld::StudentWorld(string assetPath)
-    : GameWorld(assetPath), m_gr(nullptr), m_bonusPts(START_BONUS_PTS), m_soulsSaved(0), m_lastBorderY(0)
+    : GameWorld(assetPath), m_gr(nullptr), m_bonusPts(START_BONUS_PTS), m_soulsSaved(0), m_lastBorderY(0), m_hordeMode(false), m_projectileTargetsEnd(0), m_maxTargetShift(0), m_maxTargetRadius(0)
 {
+    const char *seedText = getenv("GHOSTRACER_SEED");
+    setSeed(seedText != nullptr ? strtoull(seedText, nullptr, 10) : (static_cast<uint64_t>(random_device()()) << 32) | random_device()());
+
+    const char *threads = getenv("GHOSTRACER_THREADS");
+    if (threads != nullptr)
+    {
+        setWorkerThreads(atoi(threads));
+    }
+
+    const char *swarm = getenv("GHOSTRACER_SWARM");
+    setSwarmSteering(swarm != nullptr && atoi(swarm) == 1);
+
+    scene().addBatch(actorTraits(ProjectileRing::TYPE).depth, &m_projectiles);
 }
 
 /* Cleanup StudentWorld */
@@ -31,89 +65,356 @@ GhostRacer *StudentWorld::getGR() const
     return m_gr;
 }
 
+ActorStore &StudentWorld::store()
+{
+    return m_store;
+}
+const ActorStore &StudentWorld::store() const
+{
+    return m_store;
+}
+
+void StudentWorld::setSeed(uint64_t seed)
+{
+    m_seed = seed;
+    m_tick = 0;
+    m_nextEntityId = 1;
+    m_random = RandomStream(0);
+    resetWakeUps();
+}
+uint64_t StudentWorld::seed() const
+{
+    return m_seed;
+}
+uint32_t StudentWorld::currentTick() const
+{
+    return m_tick;
+}
+uint64_t StudentWorld::nextEntityId()
+{
+    return m_nextEntityId++;
+}
+int StudentWorld::randInt(int min, int max)
+{
+    return m_random.randInt(m_seed, m_tick, min, max);
+}
+
+void StudentWorld::setWorkerThreads(unsigned int threads)
+{
+    if (threads > 1)
+    {
+        m_pool.reset(new ThreadPool(threads));
+    }
+    else
+    {
+        m_pool.reset();
+    }
+}
+
+bool StudentWorld::setSpawnRates(const SpawnRates &rates)
+{
+    for (double rate : {rates.oilSlick, rates.human, rates.zombiePed, rates.zombieCab})
+    {
+        // a zero rate would make a spawner's chance infinite
+        if (!(rate > 0 && isfinite(rate)))
+        {
+            return false;
+        }
+    }
+    m_spawnRates = rates;
+    return true;
+}
+
+void StudentWorld::setHordeMode(bool horde)
+{
+    m_hordeMode = horde;
+    SpawnRates rates;
+    if (horde)
+    {
+        rates.zombiePed = HORDE_PED_RATE;
+        rates.zombieCab = HORDE_CAB_RATE;
+        rates.spaceCabs = false;
+    }
+    setSpawnRates(rates);
+}
+
+void StudentWorld::setSwarmSteering(bool swarm)
+{
+    m_swarm = swarm;
+}
+bool StudentWorld::swarmSteering() const
+{
+    return m_swarm;
+}
+const SpatialGrid &StudentWorld::spatialIndex() const
+{
+    return m_spatialIndex;
+}
+
+int StudentWorld::soulsForLevel() const
+{
+    return 2 * getLevel() + 5;
+}
+
 /* returns diff in souls required for level and souls already saved */
 int StudentWorld::soulsRequired() const
 {
-    return (2 * getLevel() + 5) - m_soulsSaved;
+    return soulsForLevel() - m_soulsSaved;
 }
 
 /* Initialize actors */
 int StudentWorld::init()
 {
-    // create ghostracer
+    // create ghostracer first so it takes GR_SLOT
     if (m_gr == nullptr)
     {
-        m_gr = new GhostRacer(this);
+        m_gr = resolve(spawn<GhostRacer>());
     }
 
     // create borderlines
     initBorders();
 
+    // spawn chances depend on the level
+    scheduleSpawns();
+
     return GWSTATUS_CONTINUE_GAME;
 }
 
 /* Update world for a tick */
 int StudentWorld::move()
 {
-    // let actors doSomething
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+    AllocTracker::beginTick();
+    ++m_tick;
+    int status = tick();
+    AllocTracker::endTick();
+    return status;
+}
+
+/*
+ * Call f(actor) on every live actor, type by type in UpdateOrder. With a pool
+ * each type's batch is split across threads, so f must follow the rules for
+ * beforeMove/planAfterMove in Actor.h
+ */
+template <typename F>
+void StudentWorld::forEachLiveActor(F &&f)
+{
+    UpdateOrder::forEachType([&](auto *tag) {
+        typedef typename std::remove_pointer<decltype(tag)>::type T;
+        auto runChunk = [&](size_t begin, size_t end) {
+            m_batches.forEachIn<T>(begin, end, [&](T *actor) {
+                if (actor->isAlive())
+                {
+                    f(actor);
+                }
+            });
+        };
+        if (m_pool)
+        {
+            m_pool->parallelFor(m_batches.count<T>(), PARALLEL_GRAIN, runChunk);
+        }
+        else
+        {
+            runChunk(0, m_batches.count<T>());
+        }
+    });
+}
+
+void StudentWorld::scheduleMovementPlan(const Pedestrian *ped, uint32_t ticks)
+{
+    m_movementPlans.schedule(m_tick + ticks, ped->getHandle());
+}
+
+void StudentWorld::scheduleExit(const StaticActor *actor)
+{
+    // if the GR's speed changes first, removeExitedStatics redoes this
+    m_exits.schedule(m_tick + ticksUntilExit(actor, staticDrop()), actor->getHandle());
+}
+
+/* Drop every pending wake-up, for an empty store or a restarted tick count */
+void StudentWorld::resetWakeUps()
+{
+    m_movementPlans.reset(m_tick);
+    m_exits.reset(m_tick);
+    m_exitDrop = 0;
+}
+
+/* Pixels statics scroll down this tick; the GR can't go slow enough to stop or reverse them */
+double StudentWorld::staticDrop() const
+{
+    static_assert(GhostRacer::MIN_VERT_SPEED > StaticActor::START_Y_SPEED, "statics must always scroll down");
+    return m_gr->getVertSpeed() - StaticActor::START_Y_SPEED;
+}
+
+/* Ticks until a static at its current position is moved off screen, @param drop pixels a tick; 0 if it's off already */
+uint32_t StudentWorld::ticksUntilExit(const Actor *actor, double drop) const
+{
+    if (actor->isOffScreen())
     {
-        // only doSomething if still alive
-        if ((*it)->isAlive())
+        return 0;
+    }
+    // statics never move sideways, so they leave through the bottom
+    return static_cast<uint32_t>(floor(actor->getY() / drop)) + 1;
+}
+
+/*
+ * Kill the statics the movement kernel just moved off screen. Exit ticks
+ * assume the GR keeps its speed, so when it changed they are all worked out
+ * again from where the statics are now.
+ */
+void StudentWorld::removeExitedStatics()
+{
+    double drop = staticDrop();
+    auto retireOrReschedule = [&](Actor *actor) {
+        uint32_t ticks = ticksUntilExit(actor, drop);
+        if (ticks == 0)
         {
-            (*it)->doSomething();
+            actor->setIsAlive(false);
+        }
+        else
+        {
+            m_exits.schedule(m_tick + ticks, actor->getHandle());
+        }
+    };
 
-            // check for hitting pedestrian
-            if (m_isHumanHit)
+    if (drop != m_exitDrop)
+    {
+        m_exitDrop = drop;
+        m_exits.reset(m_tick);
+        StaticTypes::forEach(m_batches, [&](Actor *actor) {
+            if (actor->isAlive())
             {
-                decLives();
-                resetHumanHit();
-                return GWSTATUS_PLAYER_DIED;
+                retireOrReschedule(actor);
             }
+        });
+        return;
+    }
 
-            // quit if GR died
-            if (!m_gr->isAlive())
-            {
-                decLives();
-                playSound(SOUND_PLAYER_DIE);
-                return GWSTATUS_PLAYER_DIED;
-            }
+    m_exits.advance(m_tick, [&](ActorHandle handle) {
+        // collected or shot since it was scheduled?
+        Actor *actor = m_store.resolve(handle);
+        if (actor != nullptr && actor->isAlive())
+        {
+            retireOrReschedule(actor);
+        }
+    });
+}
 
-            // move to next lvl if enough souls collected
-            if (soulsRequired() == 0)
-            {
-                increaseScore(m_bonusPts);
-                playSound(SOUND_FINISHED_LEVEL);
-                return GWSTATUS_FINISHED_LEVEL;
-            }
+/* Give each pedestrian whose movement plan ran out this tick a new one */
+void StudentWorld::startMovementPlans()
+{
+    m_movementPlans.advance(m_tick, [&](ActorHandle handle) {
+        // peds that walked off screen died in the kernel
+        Pedestrian *ped = static_cast<Pedestrian *>(m_store.resolve(handle));
+        if (ped != nullptr && ped->isAlive())
+        {
+            m_movementPlans.schedule(m_tick + ped->newMovementPlan(), handle);
         }
+    });
+}
+
+/* Run one tick of the simulation and return its status */
+int StudentWorld::tick()
+{
+    AllocPhaseScope updatePhase(ALLOC_PHASE_UPDATE);
+
+    // group this tick's actors by type; anything spawned mid-tick waits for the next one
+    size_t count = m_store.size();
+    m_batches.rebuild(m_store, GR_SLOT + 1);
+    if (m_swarm)
+    {
+        m_spatialIndex.rebuild(m_store, GR_SLOT + 1, SWARM_TYPES);
     }
 
-    // let the ghost racer move
-    m_gr->doSomething();
+    // Phases that may run on the pool only write the actor they're handed (or,
+    // for the kernel, its own slots) and draw only from its own random stream;
+    // everything that touches shared state (HP of others, score, sounds,
+    // spawns) waits for afterMove, which runs serially in UpdateOrder. So
+    // threads don't change results.
+
+    // let actors decide how to move (zombies turn towards GR)
+    forEachLiveActor([](auto *actor) { actor->beforeMove(); });
+
+    // move every scrolling actor at once; ones that leave the screen die here
+    double grVertSpeed = m_gr->getVertSpeed();
+    auto advance = [&](size_t begin, size_t end) {
+        advanceScrolling(m_store.xs(), m_store.ys(), m_store.horizSpeeds(), m_store.vertSpeeds(), m_store.types(), m_store.flags(),
+                         GR_SLOT + 1 + begin, GR_SLOT + 1 + end, grVertSpeed);
+    };
+    if (m_pool)
+    {
+        m_pool->parallelFor(count - (GR_SLOT + 1), KERNEL_GRAIN, advance);
+    }
+    else
+    {
+        advance(0, count - (GR_SLOT + 1));
+    }
 
-    // remove dead actors
-    for (auto it = m_objects.begin(); it != m_objects.end();)
+    // statics scrolling off screen die here too, on their scheduled tick
+    removeExitedStatics();
+
+    // holy water sweeps its path against where its targets now stand
+    if (!m_projectiles.empty())
     {
-        if (!(*it)->isAlive())
+        indexProjectileTargets();
+    }
+
+    // work out reactions against the settled positions (cab spacing)
+    forEachLiveActor([](auto *actor) { actor->planAfterMove(); });
+    startMovementPlans();
+
+    // then carry them out, in UpdateOrder
+    UpdateOrder::forEach(m_batches, [](auto *actor) {
+        if (actor->isAlive())
         {
-            delete *it;
-            it = m_objects.erase(it);
+            actor->afterMove();
         }
-        else
+    });
+    updateProjectiles();
+
+    // only actors that ended the update in the GR's band can touch it; gathered
+    // in slot order so collisions are still delivered oldest first
+    const unsigned char *types = m_store.types();
+    const unsigned char *flags = m_store.flags();
+    const double *ys = m_store.ys();
+    double grY = m_gr->getY();
+    for (size_t i = GR_SLOT + 1; i < m_store.size(); ++i)
+    {
+        if ((flags[i] & ActorStore::ALIVE) && isTypeIn(COLLIDES_GR_TYPES, types[i]) && abs(ys[i] - grY) < GR_BAND_HALF_HEIGHT)
         {
-            ++it;
+            m_grCandidates.push_back(i);
         }
     }
 
+    // deliver collisions with GR
+    int status = collideWithGR();
+    if (status != GWSTATUS_CONTINUE_GAME)
+    {
+        return status;
+    }
+
+    // let the ghost racer move
+    m_gr->doSomething();
+
+    // remove dead actors
+    {
+        AllocPhaseScope cleanupPhase(ALLOC_PHASE_CLEANUP);
+        m_store.removeDead();
+    }
+
     // update pos of last white border
     updateLastBorderY();
 
     // add new actors
-    addActors();
+    {
+        AllocPhaseScope spawnPhase(ALLOC_PHASE_SPAWN);
+        addActors();
+    }
 
     // update status text
-    setStats();
+    {
+        AllocPhaseScope statsPhase(ALLOC_PHASE_STATS);
+        setStats();
+    }
 
     // decrease bonus points each tick
     if (m_bonusPts > 0)
@@ -125,22 +426,78 @@ int StudentWorld::move()
     return GWSTATUS_CONTINUE_GAME;
 }
 
-void StudentWorld::cleanUp()
+/* Test every candidate in the GR's band at once and call onCollideGR on hits, in actor order */
+int StudentWorld::collideWithGR()
+{
+    // gather candidates into contiguous arrays for the overlap kernel
+    size_t count = m_grCandidates.size();
+    m_candidateX.resize(count);
+    m_candidateY.resize(count);
+    m_candidateRadius.resize(count);
+    m_candidateHits.resize(count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        size_t slot = m_grCandidates[k];
+        m_candidateX[k] = m_store.x(slot);
+        m_candidateY[k] = m_store.y(slot);
+        m_candidateRadius[k] = m_store.radius(slot);
+    }
+    overlapTarget(m_candidateX.data(), m_candidateY.data(), m_candidateRadius.data(), count,
+                  m_gr->getX(), m_gr->getY(), m_gr->getRadius(), m_candidateHits.data());
+
+    int status = GWSTATUS_CONTINUE_GAME;
+    for (size_t k = 0; k < count && status == GWSTATUS_CONTINUE_GAME; ++k)
+    {
+        // the horde drives through the GR, so finding the hits still costs what it would
+        if (m_candidateHits[k] && !m_hordeMode)
+        {
+            m_store.owner(m_grCandidates[k])->onCollideGR();
+            status = checkStatus();
+        }
+    }
+    m_grCandidates.clear();
+
+    // GR can also have died to a border on its own move last tick
+    return (status == GWSTATUS_CONTINUE_GAME) ? checkStatus() : status;
+}
+
+/* Check for the player dying or finishing the level */
+int StudentWorld::checkStatus()
 {
-    // delete all actors
-    for (auto it = m_objects.begin(); it != m_objects.end();)
+    // check for hitting pedestrian
+    if (m_isHumanHit)
     {
-        delete *it;
-        it = m_objects.erase(it);
+        decLives();
+        resetHumanHit();
+        return GWSTATUS_PLAYER_DIED;
     }
 
-    // delete GR
-    if (m_gr != nullptr)
+    // quit if GR died
+    if (!m_gr->isAlive())
     {
-        delete m_gr;
-        m_gr = nullptr;
+        decLives();
+        playSound(SOUND_PLAYER_DIE);
+        return GWSTATUS_PLAYER_DIED;
     }
 
+    // move to next lvl if enough souls collected
+    if (soulsRequired() == 0)
+    {
+        increaseScore(m_bonusPts);
+        playSound(SOUND_FINISHED_LEVEL);
+        return GWSTATUS_FINISHED_LEVEL;
+    }
+    return GWSTATUS_CONTINUE_GAME;
+}
+
+void StudentWorld::cleanUp()
+{
+    // delete all actors, GR included
+    m_store.clear();
+    m_gr = nullptr;
+    m_projectiles.clear();
+    resetWakeUps();
+
     resetVars();
 }
 
@@ -173,16 +530,138 @@ void StudentWorld::updateLastBorderY()
     }
 }
 
-/* Add all sorts of actors every tick */
+/* Add borders every tick, and whatever spawners are due */
 void StudentWorld::addActors()
 {
     addBorders();
-    addOilSlick();
-    addSoul();
-    addWaterGoodie();
-    addHuman();
-    addZombiePed();
-    addZombieCab();
+
+    // most ticks nothing is due and this is one comparison
+    while (m_spawnQueue.front().tick <= m_tick)
+    {
+        pop_heap(m_spawnQueue.begin(), m_spawnQueue.end(), laterSpawn<SpawnEvent>);
+        SpawnEvent &event = m_spawnQueue.back();
+        for (int n = spawnBatch(event.spawner); n > 0; --n)
+        {
+            spawnFrom(event.spawner);
+        }
+        event.tick = m_tick + ticksUntilNextSpawn(event.spawner);
+        push_heap(m_spawnQueue.begin(), m_spawnQueue.end(), laterSpawn<SpawnEvent>);
+    }
+}
+
+/* Draw every spawner's first spawn tick for this level */
+void StudentWorld::scheduleSpawns()
+{
+    for (int i = 0; i < NUM_SPAWNERS; ++i)
+    {
+        Spawner spawner = static_cast<Spawner>(i);
+        m_spawnQueue[i] = SpawnEvent{m_tick + ticksUntilNextSpawn(spawner), spawner};
+    }
+    make_heap(m_spawnQueue.begin(), m_spawnQueue.end(), laterSpawn<SpawnEvent>);
+}
+
+/* A spawner fires with a 1 in @return chance each tick: the level's chance, scaled by m_spawnRates; below 1 it fires more than once a tick */
+double StudentWorld::spawnChance(Spawner spawner) const
+{
+    double rate = 1;
+    switch (spawner)
+    {
+    case SPAWN_OIL_SLICK:
+        rate = m_spawnRates.oilSlick;
+        break;
+    case SPAWN_HUMAN:
+        rate = m_spawnRates.human;
+        break;
+    case SPAWN_ZOMBIE_PED:
+        rate = m_spawnRates.zombiePed;
+        break;
+    case SPAWN_ZOMBIE_CAB:
+        rate = m_spawnRates.zombieCab;
+        break;
+    default:
+        break;
+    }
+    return levelSpawnChance(spawner) / rate;
+}
+
+/* Actors @param spawner adds each time it fires: one, unless it's meant to fire more than once a tick */
+int StudentWorld::spawnBatch(Spawner spawner) const
+{
+    double chance = spawnChance(spawner);
+    return (chance < 1) ? static_cast<int>(ceil(1 / chance)) : 1;
+}
+
+/* Ticks until @param spawner next fires; a batch of n waits n times as long, keeping the rate */
+uint32_t StudentWorld::ticksUntilNextSpawn(Spawner spawner)
+{
+    return ticksUntilSpawn(spawnChance(spawner) * spawnBatch(spawner));
+}
+
+/* The game's own 1 in @return chance per tick, depending on level */
+int StudentWorld::levelSpawnChance(Spawner spawner) const
+{
+    switch (spawner)
+    {
+    case SPAWN_OIL_SLICK:
+        return max(150 - getLevel() * 10, 40);
+    case SPAWN_SOUL:
+        return 100;
+    case SPAWN_WATER_GOODIE:
+        return 100 + 10 * getLevel();
+    case SPAWN_HUMAN:
+        return max(200 - getLevel() * 10, 30);
+    case SPAWN_ZOMBIE_PED:
+    case SPAWN_ZOMBIE_CAB:
+    default:
+        return max(100 - getLevel() * 10, 20);
+    }
+}
+
+/*
+ * Ticks until the next success of a 1 in @param chance roll made every tick.
+ * That wait is geometric, so one inverse-CDF draw stands in for all the rolls
+ * and the spawn rate is unchanged.
+ */
+uint32_t StudentWorld::ticksUntilSpawn(double chance)
+{
+    if (chance <= 1)
+    {
+        return 1;
+    }
+    double failures = floor(log(m_random.uniform(m_seed, m_tick)) / log1p(-1.0 / chance));
+    // a tiny rate makes the wait astronomical, or infinite once 1 / chance rounds to 0
+    if (!(failures < MAX_SPAWN_WAIT - 1))
+    {
+        return MAX_SPAWN_WAIT;
+    }
+    return 1 + static_cast<uint32_t>(failures);
+}
+
+void StudentWorld::spawnFrom(Spawner spawner)
+{
+    switch (spawner)
+    {
+    case SPAWN_OIL_SLICK:
+        addOilSlick();
+        break;
+    case SPAWN_SOUL:
+        addSoul();
+        break;
+    case SPAWN_WATER_GOODIE:
+        addWaterGoodie();
+        break;
+    case SPAWN_HUMAN:
+        addHuman();
+        break;
+    case SPAWN_ZOMBIE_PED:
+        addZombiePed();
+        break;
+    case SPAWN_ZOMBIE_CAB:
+        addZombieCab();
+        break;
+    default:
+        break;
+    }
 }
 
 /* Add set of borders if enough space */
@@ -205,35 +684,35 @@ void StudentWorld::addBorders()
 /* Add a pair of yellow borders on edge of road at @param height */
 void StudentWorld::addYellowBorders(double height)
 {
-    BorderLine *leftBorder = new BorderLine(this, IID_YELLOW_BORDER_LINE, ROAD_LEFT_EDGE, height);
-    BorderLine *rightBorder = new BorderLine(this, IID_YELLOW_BORDER_LINE, ROAD_RIGHT_EDGE, height);
-    m_objects.push_back(leftBorder);
-    m_objects.push_back(rightBorder);
+    spawn<BorderLine>(IID_YELLOW_BORDER_LINE, ROAD_LEFT_EDGE, height);
+    spawn<BorderLine>(IID_YELLOW_BORDER_LINE, ROAD_RIGHT_EDGE, height);
 }
 
-/* Add a pair of whites borders at lane dividers at @param height */
+/* Add a white border on every lane divider at @param height, left to right */
 void StudentWorld::addWhiteBorders(double height)
 {
-    BorderLine *midLeftBorder = new BorderLine(this, IID_WHITE_BORDER_LINE, LEFT_DIVIDER_X, height);
-    BorderLine *midRightBorder = new BorderLine(this, IID_WHITE_BORDER_LINE, RIGHT_DIVIDER_X, height);
-    m_objects.push_back(midLeftBorder);
-    m_objects.push_back(midRightBorder);
+    for (int i = 1; i < NUM_LANES; ++i)
+    {
+        spawn<BorderLine>(IID_WHITE_BORDER_LINE, ROAD.edge(i), height);
+    }
     m_lastBorderY = height;
 }
 
-/* Set stat line */
+/* Set stat line, handing the controller a view only when a field changed */
 void StudentWorld::setStats()
 {
-    ostringstream stats;
-    stats << "Score: " << getScore();
-    stats << setw(7) << "Lvl: " << getLevel();
-    stats << setw(14) << "Souls2Save: " << soulsRequired();
-    stats << setw(9) << "Lives: " << getLives();
-    stats << setw(10) << "Health: " << m_gr->getHP();
-    stats << setw(10) << "Sprays: " << m_gr->getSprayCount();
-    stats << setw(9) << "Bonus: " << m_bonusPts;
+    m_statusLine.set(StatusLine::SCORE, getScore());
+    m_statusLine.set(StatusLine::LEVEL, getLevel());
+    m_statusLine.set(StatusLine::SOULS, soulsRequired());
+    m_statusLine.set(StatusLine::LIVES, getLives());
+    m_statusLine.set(StatusLine::HEALTH, m_gr->getHP());
+    m_statusLine.set(StatusLine::SPRAYS, m_gr->getSprayCount());
+    m_statusLine.set(StatusLine::BONUS, m_bonusPts);
 
-    setGameStatText(stats.str());
+    if (m_statusLine.takeChanged())
+    {
+        setGameStatText(m_statusLine.text());
+    }
 }
 
 /* Reset stat variables */
@@ -244,16 +723,10 @@ void StudentWorld::resetVars()
     m_lastBorderY = START_LAST_BORDER_Y;
 }
 
-/* Add oil slick to top of screen based on level */
+/* Add oil slick to top of screen at random X pos on road */
 void StudentWorld::addOilSlick()
 {
-    // add oil slick based on chance at random X pos on road
-    int chanceOilSlick = max(150 - getLevel() * 10, 40);
-    if (shouldCreateActor(chanceOilSlick))
-    {
-        OilSlick *oil = new OilSlick(this, getRandomRoadX(), VIEW_HEIGHT);
-        m_objects.push_back(oil);
-    }
+    spawn<OilSlick>(getRandomRoadX(), VIEW_HEIGHT);
 }
 /* increment souls saved count*/
 void StudentWorld::soulSaved()
@@ -264,34 +737,18 @@ void StudentWorld::soulSaved()
 /* Add soul to world */
 void StudentWorld::addSoul()
 {
-    if (shouldCreateActor(100))
-    {
-        Soul *soul = new Soul(this, getRandomRoadX(), VIEW_HEIGHT);
-        m_objects.push_back(soul);
-    }
+    spawn<Soul>(getRandomRoadX(), VIEW_HEIGHT);
 }
 
 /* Get random X coord on road */
-double StudentWorld::getRandomRoadX() const
+double StudentWorld::getRandomRoadX()
 {
     return randInt(ROAD_LEFT_EDGE, ROAD_RIGHT_EDGE);
 }
 
-/* Determine if a actor should be made based on a certain chance */
-bool StudentWorld::shouldCreateActor(int chance) const
-{
-    int upperBound = chance - 1; // randInt is inclusive, so -1 from chance
-    return randInt(0, upperBound) == 0;
-}
-
 void StudentWorld::addWaterGoodie()
 {
-    int chanceHolyWater = 100 + 10 * getLevel();
-    if (shouldCreateActor(chanceHolyWater))
-    {
-        WaterGoodie *waterGoodie = new WaterGoodie(this, getRandomRoadX(), VIEW_HEIGHT);
-        m_objects.push_back(waterGoodie);
-    }
+    spawn<WaterGoodie>(getRandomRoadX(), VIEW_HEIGHT);
 }
 
 /* Let StudentWorld know human has been hit */
@@ -307,220 +764,224 @@ void StudentWorld::resetHumanHit()
 
 void StudentWorld::addHuman()
 {
-    int chanceHuman = max(200 - getLevel() * 10, 30);
-    if (shouldCreateActor(chanceHuman))
-    {
-        HumanPedestrian *human = new HumanPedestrian(this, getRandomScreenX(), VIEW_HEIGHT);
-        m_objects.push_back(human);
-    }
+    spawn<HumanPedestrian>(getRandomScreenX(), VIEW_HEIGHT);
 }
 
 /* Get random X coord on screen */
-double StudentWorld::getRandomScreenX() const
+double StudentWorld::getRandomScreenX()
 {
     return randInt(0, VIEW_WIDTH);
 }
 
-/* Add actor to world */
-void StudentWorld::addActor(Actor *actor)
+void StudentWorld::addZombiePed()
 {
-    m_objects.push_back(actor);
+    spawn<ZombiePedestrian>(getRandomScreenX(), VIEW_HEIGHT);
 }
 
-void StudentWorld::addZombiePed()
+bool StudentWorld::sprayHolyWater(double x, double y, int direction)
+{
+    return m_projectiles.push(x, y, direction);
+}
+
+const ProjectileRing &StudentWorld::projectiles() const
+{
+    return m_projectiles;
+}
+
+/* Holy water in flight, oldest first: hit what it ran into since it was last checked, or fly on */
+void StudentWorld::updateProjectiles()
 {
-    int chanceZombie = max(100 - getLevel() * 10, 20);
-    if (shouldCreateActor(chanceZombie))
+    size_t i = 0;
+    while (i < m_projectiles.size())
     {
-        ZombiePedestrian *zombie = new ZombiePedestrian(this, getRandomScreenX(), VIEW_HEIGHT);
-        m_objects.push_back(zombie);
+        double x = m_projectiles.x(i);
+        double y = m_projectiles.y(i);
+        size_t hit = findSweptProjectileHit(m_projectiles.fromX(i), m_projectiles.fromY(i), x, y);
+        // an earlier hit this tick may have dropped a goodie we now overlap
+        if (hit == NO_SLOT)
+        {
+            hit = findProjectileHit(x, y, m_projectileTargetsEnd, m_store.size());
+        }
+
+        // if projectile hits hittable actor, drop the projectile and let the actor take the damage
+        if (hit != NO_SLOT)
+        {
+            m_store.owner(hit)->onCollideWater();
+            m_projectiles.remove(i);
+        }
+        else if (!m_projectiles.advance(i))
+        {
+            m_projectiles.remove(i);
+        }
+        else
+        {
+            ++i;
+        }
     }
 }
 
-/* Check all actors for holy water collisions*/
-bool StudentWorld::checkProjectileHit(HolyWater *projectile)
+/* Find the first actor in slots [begin, end) that holy water at (x, y) would hit */
+size_t StudentWorld::findProjectileHit(double x, double y, size_t begin, size_t end) const
 {
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+    for (size_t i = begin; i < end; ++i)
     {
-        // only collide with holy water if actor can and is overlapping w/ holy water
-        if ((*it)->canCollideWater() && (*it)->isOverlapping(projectile))
+        // same box as Actor::isOverlapping
+        double radiusSum = ProjectileRing::RADIUS + m_store.radius(i);
+        if (isTypeIn(COLLIDES_WATER_TYPES, m_store.type(i)) &&
+            abs(m_store.x(i) - x) < radiusSum * Actor::X_SCALE && abs(m_store.y(i) - y) < radiusSum * Actor::Y_SCALE)
         {
-            (*it)->onCollideWater();
-            // let holy water know it hit something
-            return true;
+            return i;
         }
     }
-    // let holy water know it didn't hit something
-    return false;
+    return NO_SLOT;
 }
 
-/* Add zombie cab depending if there's space on screen */
-void StudentWorld::addZombieCab()
+void StudentWorld::indexProjectileTargets()
 {
-    int chanceCab = max(100 - getLevel() * 10, 20);
-    if (shouldCreateActor(chanceCab))
+    m_projectileTargets.rebuild(m_store, GR_SLOT + 1, COLLIDES_WATER_TYPES);
+    m_projectileTargetsEnd = m_store.size();
+
+    // how far a target's box can reach: its size, and how far it moved this tick
+    const unsigned char *types = m_store.types();
+    const double *horizSpeeds = m_store.horizSpeeds();
+    const double *vertSpeeds = m_store.vertSpeeds();
+    double grVertSpeed = m_gr->getVertSpeed();
+    m_maxTargetShift = 0;
+    m_maxTargetRadius = 0;
+    for (size_t i = GR_SLOT + 1; i < m_store.size(); ++i)
     {
-        set<int> checkedLanes;
-        bool foundLane = false;
-        // get random lane to check
-        int curLane = randInt(1, NUM_LANES);
-        double startX;
-        double startY;
-        double ySpeed;
+        if (isTypeIn(COLLIDES_WATER_TYPES, types[i]))
+        {
+            m_maxTargetShift = max(m_maxTargetShift, max(abs(horizSpeeds[i]), abs(vertSpeeds[i] - grVertSpeed)));
+            m_maxTargetRadius = max(m_maxTargetRadius, m_store.radius(i));
+        }
+    }
+}
 
-        // look for new lane to insert if we haven't found a lane and haven't checked all lanes
-        while (!foundLane && checkedLanes.size() != NUM_LANES)
+/* Broadphase over the segment's box grown by the largest target and target move, then the exact test in each target's frame */
+size_t StudentWorld::findSweptProjectileHit(double fromX, double fromY, double toX, double toY) const
+{
+    const double radius = ProjectileRing::RADIUS;
+    double reachX = (radius + m_maxTargetRadius) * Actor::X_SCALE + m_maxTargetShift;
+    double reachY = (radius + m_maxTargetRadius) * Actor::Y_SCALE + m_maxTargetShift;
+    double grVertSpeed = m_gr->getVertSpeed();
+
+    size_t hit = NO_SLOT;
+    double hitAt = SEGMENT_MISSES;
+    m_projectileTargets.forEachInBox(min(fromX, toX) - reachX, min(fromY, toY) - reachY, max(fromX, toX) + reachX, max(fromY, toY) + reachY,
+                                     COLLIDES_WATER_TYPES, [&](size_t slot, double x, double y) {
+        // where the projectile started, seen from the target before its move this tick
+        double startX = fromX + m_store.horizSpeed(slot);
+        double startY = fromY + (m_store.vertSpeed(slot) - grVertSpeed);
+        double radiusSum = radius + m_store.radius(slot);
+        double at = segmentEntry(startX, startY, toX, toY, x, y, radiusSum * Actor::X_SCALE, radiusSum * Actor::Y_SCALE);
+        if (at != SEGMENT_MISSES && (at < hitAt || (at == hitAt && slot < hit)))
         {
-            checkedLanes.insert(curLane);
-            switch (curLane)
-            {
-            case 1:
-                // check lane 1 top of screen for space
-                if (distanceClosestCAWActor(ROAD_LEFT_EDGE, LEFT_DIVIDER_X, 0) > VIEW_HEIGHT / 3)
-                {
-                    foundLane = true;
-                    startX = LEFT_LANE_CENTER;
-                    startY = SPRITE_HEIGHT / 2;
-                    ySpeed = getGR()->getVertSpeed() + getCabSpeedModifier();
-                    break;
-                }
-                // check lane 1 bottom of screen for space
-                if (distanceClosestCAWActor(ROAD_LEFT_EDGE, LEFT_DIVIDER_X, VIEW_HEIGHT) > VIEW_HEIGHT / 3)
-                {
-                    foundLane = true;
-                    startX = LEFT_LANE_CENTER;
-                    startY = VIEW_HEIGHT - SPRITE_HEIGHT / 2;
-                    ySpeed = getGR()->getVertSpeed() - getCabSpeedModifier();
-                    break;
-                }
-            case 2:
-                // check lane 2 top of screen for space
-                if (distanceClosestCAWActor(LEFT_DIVIDER_X, RIGHT_DIVIDER_X, 0) > VIEW_HEIGHT / 3)
-                {
-                    foundLane = true;
-                    startX = ROAD_CENTER;
-                    startY = SPRITE_HEIGHT / 2;
-                    ySpeed = getGR()->getVertSpeed() + getCabSpeedModifier();
-                    break;
-                }
-                // check lane 2 bottom of screen for space
-                if (distanceClosestCAWActor(LEFT_DIVIDER_X, RIGHT_DIVIDER_X, VIEW_HEIGHT) > VIEW_HEIGHT / 3)
-                {
-                    foundLane = true;
-                    startX = ROAD_CENTER;
-                    startY = VIEW_HEIGHT - SPRITE_HEIGHT / 2;
-                    ySpeed = getGR()->getVertSpeed() - getCabSpeedModifier();
-                    break;
-                }
-            case 3:
-                // check lane 3 top of screen for space
-                if (distanceClosestCAWActor(RIGHT_DIVIDER_X, ROAD_RIGHT_EDGE, 0) > VIEW_HEIGHT / 3)
-                {
-                    foundLane = true;
-                    startX = RIGHT_LANE_CENTER;
-                    startY = SPRITE_HEIGHT / 2;
-                    ySpeed = getGR()->getVertSpeed() + getCabSpeedModifier();
-                    break;
-                }
-                // check lane 3 bottom of screen for space
-                if (distanceClosestCAWActor(RIGHT_DIVIDER_X, ROAD_RIGHT_EDGE, VIEW_HEIGHT) > VIEW_HEIGHT / 3)
-                {
-                    foundLane = true;
-                    startX = RIGHT_LANE_CENTER;
-                    startY = VIEW_HEIGHT - SPRITE_HEIGHT / 2;
-                    ySpeed = getGR()->getVertSpeed() - getCabSpeedModifier();
-                    break;
-                }
-            }
+            hit = slot;
+            hitAt = at;
+        }
+    });
+    return hit;
+}
 
-            // find next lane to check, since current lane not suitable
-            // if all lanes, checked, curLane not changed, but while loop above ends
-            for (int i = 1; i <= NUM_LANES; ++i)
-            {
-                if (checkedLanes.find(i) == checkedLanes.end())
-                {
-                    curLane = i;
-                    break;
-                }
-            }
+/* Add zombie cab depending if there's space on screen (anywhere, if cabs needn't be spaced) */
+void StudentWorld::addZombieCab()
+{
+    if (!m_spawnRates.spaceCabs)
+    {
+        // a crowd of cabs would make this a scan per cab; drive into whatever's there
+        int lane = randInt(1, NUM_LANES) - 1;
+        if (randInt(0, 1) == 0)
+        {
+            spawn<ZombieCab>(getGR()->getVertSpeed() + getCabSpeedModifier(), ROAD.center(lane), SPRITE_HEIGHT / 2);
         }
+        else
+        {
+            spawn<ZombieCab>(getGR()->getVertSpeed() - getCabSpeedModifier(), ROAD.center(lane), VIEW_HEIGHT - SPRITE_HEIGHT / 2);
+        }
+        return;
+    }
+
+    AllocPhaseScope cabLanesPhase(ALLOC_PHASE_CAB_LANES);
+    LaneOccupancy occupancy = laneOccupancy();
 
-        // add cab if good lane found
-        if (foundLane)
+    // try every lane once, starting from a random one; in each, a cab
+    // coming up from the bottom goes before one coming down from the top
+    int firstLane = randInt(1, NUM_LANES) - 1;
+    for (int i = 0; i < NUM_LANES; ++i)
+    {
+        int lane = (firstLane + i) % NUM_LANES;
+        if (occupancy.fromBottom[lane] > VIEW_HEIGHT / 3)
+        {
+            spawn<ZombieCab>(getGR()->getVertSpeed() + getCabSpeedModifier(), ROAD.center(lane), SPRITE_HEIGHT / 2);
+            return;
+        }
+        if (occupancy.fromTop[lane] > VIEW_HEIGHT / 3)
         {
-            ZombieCab *cab = new ZombieCab(this, ySpeed, startX, startY);
-            m_objects.push_back(cab);
+            spawn<ZombieCab>(getGR()->getVertSpeed() - getCabSpeedModifier(), ROAD.center(lane), VIEW_HEIGHT - SPRITE_HEIGHT / 2);
+            return;
         }
     }
 }
 
-/* Finds shortest absolute distance */
-double StudentWorld::distanceClosestCAWActor(double xMin, double xMax, double y) const
+/* Distance from each end of the screen to the nearest CAW actor in each lane, in one pass over the store */
+StudentWorld::LaneOccupancy StudentWorld::laneOccupancy() const
 {
-    // minDist initialized to max height in case no actors found in lane
-    double minDist = VIEW_HEIGHT;
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+    // VIEW_HEIGHT in case no actors are found in a lane
+    LaneOccupancy occupancy;
+    for (int lane = 0; lane < NUM_LANES; ++lane)
     {
-        // if CAW actor and in lane, find absolute distance from y pos
-        if ((*it)->isCAW() && (*it)->getX() >= xMin && (*it)->getX() < xMax)
-        {
-            double dist = abs((*it)->getY() - y);
-            if (dist < minDist)
-            {
-                minDist = dist;
-            }
-        }
+        occupancy.fromBottom[lane] = VIEW_HEIGHT;
+        occupancy.fromTop[lane] = VIEW_HEIGHT;
     }
 
-    // check ghost racer distance (its not in the actors vec)
-    if (getGR()->getX() >= xMin && getGR()->getX() < xMax)
+    const double *xs = m_store.xs();
+    const double *ys = m_store.ys();
+    const unsigned char *types = m_store.types();
+    // GR is CAW and lives in the store, so it is covered here too
+    for (size_t i = 0; i < m_store.size(); ++i)
     {
-        double dist = abs(getGR()->getY() - y);
-        if (dist < minDist)
+        if (!isTypeIn(CAW_TYPES, types[i]))
         {
-            minDist = dist;
+            continue;
         }
+        int lane = ROAD.laneAt(xs[i]);
+        if (lane < 0)
+        {
+            continue;
+        }
+        occupancy.fromBottom[lane] = min(occupancy.fromBottom[lane], abs(ys[i]));
+        occupancy.fromTop[lane] = min(occupancy.fromTop[lane], abs(ys[i] - VIEW_HEIGHT));
     }
-    // return the smallest distance from Y pos
-    return minDist;
+    return occupancy;
 }
 
 /* Determine closest CAW actor in front or behind cab */
 double StudentWorld::directionalDistanceClosetCAWActor(const ZombieCab *cab, bool inFront) const
 {
-    double xMin;
-    double xMax;
+    // X bounds of the cab's lane
     int lane = cab->getLane();
-
-    // get X bounds based on lane
-    switch (lane)
-    {
-    case 1:
-        xMin = ROAD_LEFT_EDGE;
-        xMax = LEFT_DIVIDER_X;
-        break;
-    case 2:
-        xMin = LEFT_DIVIDER_X;
-        xMax = RIGHT_DIVIDER_X;
-        break;
-    case 3:
-        xMin = RIGHT_DIVIDER_X;
-        xMax = ROAD_RIGHT_EDGE;
-        break;
-    }
+    double xMin = ROAD.edge(lane);
+    double xMax = ROAD.edge(lane + 1);
 
     double minDist = VIEW_HEIGHT; // set as such to return in case of no actor found
-    for (auto it = m_objects.begin(); it != m_objects.end(); ++it)
+    const double *xs = m_store.xs();
+    const double *ys = m_store.ys();
+    const unsigned char *types = m_store.types();
+    size_t cabSlot = cab->getSlot();
+    double cabY = ys[cabSlot];
+    // GR is CAW and lives in the store, so it is covered here too
+    for (size_t i = 0; i < m_store.size(); ++i)
     {
         // don't consider cab itself
-        if ((*it) == cab)
+        if (i == cabSlot)
         {
             continue;
         }
         // only check CAW actors within x bounds
-        if ((*it)->isCAW() && (*it)->getX() >= xMin && (*it)->getX() < xMax)
+        if (isTypeIn(CAW_TYPES, types[i]) && xs[i] >= xMin && xs[i] < xMax)
         {
-            double dist = (*it)->getY() - cab->getY();
+            double dist = ys[i] - cabY;
             // only consider actors in proper direction from cab
             if ((inFront && dist < 0) || (!inFront && dist > 0))
             {
@@ -534,28 +995,12 @@ double StudentWorld::directionalDistanceClosetCAWActor(const ZombieCab *cab, boo
         }
     }
 
-    // check GR for distance to cab
-    if (getGR()->getX() >= xMin && getGR()->getX() < xMax)
-    {
-        double dist = getGR()->getY() - cab->getY();
-        // if GR not in right dir, just return
-        if ((inFront && dist < 0) || (!inFront && dist > 0))
-        {
-            return minDist;
-        }
-        dist = abs(dist);
-        if (dist < minDist)
-        {
-            minDist = dist;
-        }
-    }
-
     // return shortest distance to CAW actor either in front or behind actor (inFront boolean)
     return minDist;
 }
 
 /* Add variation to cab speed on initialization */
-double StudentWorld::getCabSpeedModifier() const
+double StudentWorld::getCabSpeedModifier()
 {
     return randInt(2, 4);
 }
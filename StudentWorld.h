@@ -3,8 +3,21 @@
 
 #include "GameWorld.h"
 #include "Actor.h"
+#include "StatusLine.h"
+#include "ActorStore.h"
+#include "ActorBatches.h"
+#include "ThreadPool.h"
+#include "TimerWheel.h"
+#include "SpatialGrid.h"
+#include "ProjectileRing.h"
+#include "Random.h"
+#include "Road.h"
+#include "AllocTracker.h"
 #include <string>
 #include <vector>
+#include <array>
+#include <memory>
+#include <utility>
 
 // Students:  Add code to this file, StudentWorld.cpp, Actor.h, and Actor.cpp
 
@@ -18,13 +31,23 @@ public:
     static const int N_YELLOW_LINES = VIEW_HEIGHT / SPRITE_HEIGHT;
     static const int M_WHITE_LINES = VIEW_HEIGHT / (4 * SPRITE_HEIGHT);
 
-    static constexpr double ROAD_LEFT_EDGE = ROAD_CENTER - ROAD_WIDTH / 2;
-    static constexpr double ROAD_RIGHT_EDGE = ROAD_CENTER + ROAD_WIDTH / 2;
-    static constexpr double LEFT_DIVIDER_X = ROAD_LEFT_EDGE + ROAD_WIDTH / 3;
-    static constexpr double RIGHT_DIVIDER_X = ROAD_RIGHT_EDGE - ROAD_WIDTH / 3; 
-    static constexpr double LEFT_LANE_CENTER = ROAD_CENTER - ROAD_WIDTH / 3;
-    static constexpr double RIGHT_LANE_CENTER = ROAD_CENTER + ROAD_WIDTH / 3;
-    static const int NUM_LANES = 3;
+    // lane geometry lives in ROAD (Road.h)
+    static constexpr double ROAD_LEFT_EDGE = ROAD.leftEdge();
+    static constexpr double ROAD_RIGHT_EDGE = ROAD.rightEdge();
+    static const int NUM_LANES = Road::NUM_LANES;
+    static const size_t GR_SLOT = 0; // GR is created first and never removed, so it always has slot 0
+    static const size_t NO_SLOT = ~static_cast<size_t>(0);
+    // actors per chunk handed to a worker thread; below this a pass runs inline
+    static const size_t PARALLEL_GRAIN = 256;
+    static const size_t KERNEL_GRAIN = 4096;
+    static constexpr ActorTypeMask SWARM_TYPES = (1u << ACTOR_ZOMBIE_PED) | (1u << ACTOR_ZOMBIE_CAB);
+    // setHordeMode's spawn rate multipliers: enough to keep over 10k zombies on screen
+    static constexpr double HORDE_PED_RATE = 20000;
+    static constexpr double HORDE_CAB_RATE = 100;
+    // longest wait ticksUntilSpawn returns; a spawner that slow never fires in a real run
+    static const std::uint32_t MAX_SPAWN_WAIT = 1u << 30;
+    // GR never moves vertically, so nothing farther than this from its Y can overlap it
+    static constexpr double GR_BAND_HALF_HEIGHT = (actorTraits(GhostRacer::TYPE).size + maxSizeOf(COLLIDES_GR_TYPES)) * GraphObject::RADIUS_PER_UNIT * Actor::Y_SCALE;
 
     // constructor, destructor, essential methods
     StudentWorld(std::string assetPath);
@@ -34,42 +57,212 @@ public:
     virtual void cleanUp();
 
     GhostRacer *getGR() const;
+    ActorStore &store();
+    const ActorStore &store() const;
+
+    // Every random draw is keyed by this seed; setting it restarts the tick and
+    // entity counters, so a world seeded before init replays exactly. Defaults
+    // to GHOSTRACER_SEED from the environment, or a fresh random seed.
+    void setSeed(std::uint64_t seed);
+    std::uint64_t seed() const;
+    std::uint32_t currentTick() const;
+    // id for a new actor's RandomStream; 0 is the world's own stream
+    std::uint64_t nextEntityId();
+    // draw from the world's stream (spawn rolls)
+    int randInt(int min, int max);
+
+    // Run the per-actor passes on @param threads threads (1 = serial). Results
+    // are identical either way. Defaults to GHOSTRACER_THREADS from the environment.
+    void setWorkerThreads(unsigned int threads);
+
+    // Positive multipliers on how often the level's random spawners fire (1 = the
+    // game's own rates); past once a tick a spawner adds several actors at a
+    // time. Takes effect from the next init.
+    struct SpawnRates
+    {
+        double oilSlick = 1;
+        double human = 1;
+        double zombiePed = 1;
+        double zombieCab = 1;
+        // false lets cabs spawn into lanes already crowded with traffic
+        bool spaceCabs = true;
+    };
+    // false, keeping the rates as they were, unless every multiplier is positive and finite
+    bool setSpawnRates(const SpawnRates &rates);
+    // Stress scenario: zombie peds and cabs spawning by the hundred each tick,
+    // with cabs unspaced, and a GR nothing collides with, so the crowd keeps
+    // growing instead of the level restarting. Takes effect from the next init.
+    void setHordeMode(bool horde);
+
+    // Zombie peds also keep their distance from each other and sidestep cabs,
+    // finding them with radius queries on spatialIndex(). Defaults to
+    // GHOSTRACER_SWARM from the environment (off unless set to 1).
+    void setSwarmSteering(bool swarm);
+    bool swarmSteering() const;
+    // the SWARM_TYPES where they stood at the start of this tick; only built with swarm steering on
+    const SpatialGrid &spatialIndex() const;
     void soulSaved();
     void humanHit();
-    void addActor(Actor *actor);
-    bool checkProjectileHit(HolyWater *projectile);
-    double distanceClosestCAWActor(double xMin, double xMax, double y) const;
+    // souls to save to finish the current level, and how many are still to go
+    int soulsForLevel() const;
+    int soulsRequired() const;
+
+    // Timed wake-ups, so countdowns cost nothing on the ticks in between:
+    // @param ped picks a new movement plan in @param ticks ticks, and
+    // @param actor dies on the tick it scrolls off screen (kept up to date as
+    // the GR changes speed)
+    void scheduleMovementPlan(const Pedestrian *ped, std::uint32_t ticks);
+    void scheduleExit(const StaticActor *actor);
+
+    // create an actor of type T in this world; the world's store owns it
+    template <typename T, typename... Args>
+    Handle<T> spawn(Args &&...args)
+    {
+        AllocPhaseScope spawnPhase(ALLOC_PHASE_SPAWN);
+        T *actor = new T(this, std::forward<Args>(args)...);
+        return Handle<T>(actor->getHandle());
+    }
+
+    // returns the actor @param handle refers to, or nullptr if it was removed
+    template <typename T>
+    T *resolve(Handle<T> handle) const
+    {
+        return static_cast<T *>(m_store.resolve(handle.raw()));
+    }
+
+    /*
+     * Order the per-type update passes visit batches in; within a batch actors
+     * run in creation order. Statics first (only animation), then pedestrians
+     * and cabs, whose afterMove only plays zombie grunts. Holy water flies
+     * after all of them (updateProjectiles), so it hits actors that have
+     * finished reacting to the move.
+     */
+    typedef ActorTypeList<BorderLine, OilSlick, Soul, HealGoodie, WaterGoodie,
+                          HumanPedestrian, ZombiePedestrian, ZombieCab> UpdateOrder;
+    // the types in EXIT_SCHEDULED_TYPES
+    typedef ActorTypeList<BorderLine, OilSlick, Soul, HealGoodie, WaterGoodie> StaticTypes;
+
+    // spray holy water from (x, y) towards @param direction; false if the most that can be in flight already are
+    bool sprayHolyWater(double x, double y, int direction);
+    const ProjectileRing &projectiles() const;
+
+    // first water-collidable slot in [begin, end) overlapping a projectile at (x, y), or NO_SLOT
+    size_t findProjectileHit(double x, double y, size_t begin, size_t end) const;
+    /*
+     * The water-collidable actor a projectile ran into on its way from
+     * (fromX, fromY), where it was last checked, to (toX, toY), or NO_SLOT.
+     * The path is swept against each target in the target's own frame, so a
+     * projectile and target closing fast can't pass through each other
+     * between ticks. The earliest hit along the path wins, the older actor on
+     * a tie. Reads the index indexProjectileTargets builds.
+     */
+    size_t findSweptProjectileHit(double fromX, double fromY, double toX, double toY) const;
+    // index the water-collidable actors where they stand; the tick does this after moving actors whenever holy water is in flight
+    void indexProjectileTargets();
     double directionalDistanceClosetCAWActor(const ZombieCab *cab, bool inFront) const;
 
 private:
+    // Random spawn sources, in the order addActors used to roll them; spawns
+    // due on the same tick fire in this order
+    enum Spawner
+    {
+        SPAWN_OIL_SLICK,
+        SPAWN_SOUL,
+        SPAWN_WATER_GOODIE,
+        SPAWN_HUMAN,
+        SPAWN_ZOMBIE_PED,
+        SPAWN_ZOMBIE_CAB,
+        NUM_SPAWNERS
+    };
+
+    struct SpawnEvent
+    {
+        std::uint32_t tick;
+        Spawner spawner;
+    };
+
+    // how far the nearest CAW actor in each lane is from either end of the
+    // screen (y = 0 and y = VIEW_HEIGHT), VIEW_HEIGHT if the lane is empty
+    struct LaneOccupancy
+    {
+        double fromBottom[NUM_LANES];
+        double fromTop[NUM_LANES];
+    };
+
+    ActorStore m_store;
+    ActorBatches m_batches;
+    std::unique_ptr<ThreadPool> m_pool;
+    std::uint64_t m_seed;
+    std::uint32_t m_tick;
+    std::uint64_t m_nextEntityId;
+    RandomStream m_random;
     GhostRacer *m_gr;
-    std::vector<Actor *> m_objects;
     int m_soulsSaved;
     int m_bonusPts;
     double m_lastBorderY;
     bool m_isHumanHit;
+    StatusLine m_statusLine;
+    // every spawner's next spawn, as a min-heap on (tick, spawner)
+    std::array<SpawnEvent, NUM_SPAWNERS> m_spawnQueue;
+    TimerWheel m_movementPlans;
+    TimerWheel m_exits;
+    double m_exitDrop; // how far statics scroll per tick, as m_exits assumes; 0 when nothing is assumed
+    SpawnRates m_spawnRates;
+    bool m_hordeMode;
+    bool m_swarm;
+    SpatialGrid m_spatialIndex;
+    ProjectileRing m_projectiles;
+    SpatialGrid m_projectileTargets;
+    size_t m_projectileTargetsEnd; // store size when m_projectileTargets was built; later slots aren't in it
+    // farthest any indexed projectile target moved this tick on either axis, and the largest one's radius
+    double m_maxTargetShift;
+    double m_maxTargetRadius;
+
+    // scratch space for the GR overlap pass, reused every tick
+    std::vector<size_t> m_grCandidates;
+    std::vector<double> m_candidateX;
+    std::vector<double> m_candidateY;
+    std::vector<double> m_candidateRadius;
+    std::vector<unsigned char> m_candidateHits;
 
     // helper methods
+    int tick();
+    template <typename F>
+    void forEachLiveActor(F &&f);
+    int collideWithGR();
+    void updateProjectiles();
+    void startMovementPlans();
+    void removeExitedStatics();
+    double staticDrop() const;
+    std::uint32_t ticksUntilExit(const Actor *actor, double drop) const;
+    void resetWakeUps();
+    int checkStatus();
     void addYellowBorders(double height);
     void addWhiteBorders(double height);
     void initBorders();
     void addBorders();
     void addActors();
+    void scheduleSpawns();
+    double spawnChance(Spawner spawner) const;
+    int spawnBatch(Spawner spawner) const;
+    std::uint32_t ticksUntilNextSpawn(Spawner spawner);
+    int levelSpawnChance(Spawner spawner) const;
+    std::uint32_t ticksUntilSpawn(double chance);
+    void spawnFrom(Spawner spawner);
     void addOilSlick();
     void addSoul();
     void addWaterGoodie();
     void addHuman();
     void addZombiePed();
     void addZombieCab();
-    bool shouldCreateActor(int chance) const;
-    double getCabSpeedModifier() const;
+    LaneOccupancy laneOccupancy() const;
+    double getCabSpeedModifier();
 
     void updateLastBorderY();
     void setStats();
     void resetVars();
-    int soulsRequired() const;
-    double getRandomRoadX() const;
-    double getRandomScreenX() const;
+    double getRandomRoadX();
+    double getRandomScreenX();
     void resetHumanHit();
 };
 
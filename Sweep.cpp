@@ -0,0 +1,286 @@
+#include "Sweep.h"
+#include "Autopilot.h"
+#include "Random.h"
+#include "StudentWorld.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace
+{
+    typedef chrono::steady_clock Clock;
+
+    // Everything the sweep is asked to cover; each list is one axis of the grid
+    struct SweepOptions
+    {
+        vector<double> levels = {1, 4, 7, 10};
+        vector<double> oilSlick = {1};
+        vector<double> human = {1};
+        vector<double> zombiePed = {1, 2, 4};
+        vector<double> zombieCab = {1, 2, 4};
+        int games = 8;
+        int maxTicks = 10000;
+        unsigned int threads = 0;
+        uint64_t seed = 1;
+        const char *output = nullptr; // stdout when not given
+    };
+
+    struct Config
+    {
+        int level;
+        StudentWorld::SpawnRates rates;
+    };
+
+    struct GameResult
+    {
+        int ticks;
+        bool gameOver; // false if the game was still going at maxTicks
+        int finalLevel;
+        int score;
+        size_t peakActors;
+        vector<float> tickNs;
+    };
+
+    // Hands the world the key the autopilot picked outside the timed tick
+    struct Keyboard : public GameServices
+    {
+        int key = 0;
+
+        bool getLastKey(int &value) override
+        {
+            value = key;
+            key = 0;
+            return value != 0;
+        }
+        void playSound(int) override {}
+        void setGameStatText(string_view) override {}
+        void setMsPerTick(int) override {}
+        void quitGame() override {}
+    };
+
+    /* Parse "1,2.5,4" into @param values; false if any entry isn't a positive number */
+    bool parseList(const char *text, vector<double> &values)
+    {
+        values.clear();
+        while (*text != '\0')
+        {
+            char *end;
+            double value = strtod(text, &end);
+            if (end == text || !(value > 0 && isfinite(value)) || (*end != ',' && *end != '\0'))
+            {
+                return false;
+            }
+            values.push_back(value);
+            text = (*end == ',') ? end + 1 : end;
+        }
+        return !values.empty();
+    }
+
+    bool parseOptions(int argc, char *argv[], SweepOptions &options)
+    {
+        for (int i = 0; i < argc; i += 2)
+        {
+            if (i + 1 >= argc)
+            {
+                return false;
+            }
+            const char *name = argv[i];
+            const char *value = argv[i + 1];
+            bool ok = true;
+            if (strcmp(name, "-levels") == 0)
+                ok = parseList(value, options.levels);
+            else if (strcmp(name, "-oil") == 0)
+                ok = parseList(value, options.oilSlick);
+            else if (strcmp(name, "-humans") == 0)
+                ok = parseList(value, options.human);
+            else if (strcmp(name, "-peds") == 0)
+                ok = parseList(value, options.zombiePed);
+            else if (strcmp(name, "-cabs") == 0)
+                ok = parseList(value, options.zombieCab);
+            else if (strcmp(name, "-games") == 0)
+                ok = (options.games = atoi(value)) > 0;
+            else if (strcmp(name, "-ticks") == 0)
+                ok = (options.maxTicks = atoi(value)) > 0;
+            else if (strcmp(name, "-threads") == 0)
+                options.threads = atoi(value);
+            else if (strcmp(name, "-seed") == 0)
+                options.seed = strtoull(value, nullptr, 10);
+            else if (strcmp(name, "-o") == 0)
+                options.output = value;
+            else
+                ok = false;
+            if (!ok)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    vector<Config> buildConfigs(const SweepOptions &options)
+    {
+        vector<Config> configs;
+        for (double level : options.levels)
+            for (double oilSlick : options.oilSlick)
+                for (double human : options.human)
+                    for (double zombiePed : options.zombiePed)
+                        for (double zombieCab : options.zombieCab)
+                        {
+                            Config config;
+                            config.level = max(1, static_cast<int>(level));
+                            config.rates.oilSlick = oilSlick;
+                            config.rates.human = human;
+                            config.rates.zombiePed = zombiePed;
+                            config.rates.zombieCab = zombieCab;
+                            configs.push_back(config);
+                        }
+        return configs;
+    }
+
+    /*
+     * Play one game from @param config's level until game over or @param
+     * maxTicks. Only the world's tick is timed; the autopilot picks its key
+     * before the clock starts.
+     */
+    GameResult playGame(const Config &config, uint64_t seed, int maxTicks)
+    {
+        StudentWorld world("");
+        world.setWorkerThreads(1);
+        world.setSpawnRates(config.rates);
+        Keyboard keyboard;
+        world.setServices(&keyboard);
+        Autopilot pilot(world);
+        for (int level = 1; level < config.level; ++level)
+        {
+            world.advanceToNextLevel();
+        }
+        world.setSeed(seed);
+        world.init();
+
+        GameResult result = {0, false, 0, 0, 0, vector<float>()};
+        result.tickNs.reserve(maxTicks);
+        while (result.ticks < maxTicks)
+        {
+            keyboard.key = pilot.chooseKey();
+            Clock::time_point start = Clock::now();
+            int status = world.move();
+            result.tickNs.push_back(chrono::duration<float, nano>(Clock::now() - start).count());
+            ++result.ticks;
+            result.peakActors = max(result.peakActors, world.store().size());
+
+            if (status == GWSTATUS_PLAYER_DIED && world.isGameOver())
+            {
+                result.gameOver = true;
+                break;
+            }
+            if (status == GWSTATUS_FINISHED_LEVEL)
+            {
+                world.advanceToNextLevel();
+            }
+            if (status != GWSTATUS_CONTINUE_GAME)
+            {
+                world.cleanUp();
+                world.init();
+            }
+        }
+        result.finalLevel = world.getLevel();
+        result.score = world.getScore();
+        return result;
+    }
+
+    // the @param fraction quantile of @param sorted
+    float percentile(const vector<float> &sorted, double fraction)
+    {
+        return sorted[min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()))];
+    }
+
+    void writeRow(FILE *out, const Config &config, const GameResult *games, int count)
+    {
+        double ticks = 0, score = 0, level = 0, peak = 0;
+        size_t maxPeak = 0;
+        int over = 0;
+        vector<float> tickNs;
+        for (int g = 0; g < count; ++g)
+        {
+            const GameResult &game = games[g];
+            ticks += game.ticks;
+            score += game.score;
+            level += game.finalLevel;
+            peak += game.peakActors;
+            maxPeak = max(maxPeak, game.peakActors);
+            over += game.gameOver;
+            tickNs.insert(tickNs.end(), game.tickNs.begin(), game.tickNs.end());
+        }
+        sort(tickNs.begin(), tickNs.end());
+
+        fprintf(out, "%d,%g,%g,%g,%g,%d,%d,%.1f,%.1f,%.2f,%.1f,%zu,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+                config.level, config.rates.oilSlick, config.rates.human, config.rates.zombiePed, config.rates.zombieCab,
+                count, over, ticks / count, score / count, level / count, peak / count, maxPeak,
+                percentile(tickNs, 0.5), percentile(tickNs, 0.9), percentile(tickNs, 0.99),
+                percentile(tickNs, 0.999), tickNs.back());
+    }
+}
+
+int runSweep(int argc, char *argv[])
+{
+    SweepOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        fprintf(stderr, "usage: -sweep [-levels 1,4,7,10] [-oil 1] [-humans 1] [-peds 1,2,4] [-cabs 1,2,4]\n"
+                        "              [-games 8] [-ticks 10000] [-threads 0] [-seed 1] [-o file.csv]\n"
+                        "  rate lists multiply the level's spawn rates; -threads 0 uses every core\n");
+        return 1;
+    }
+    FILE *out = (options.output != nullptr) ? fopen(options.output, "w") : stdout;
+    if (out == nullptr)
+    {
+        fprintf(stderr, "cannot write %s\n", options.output);
+        return 1;
+    }
+
+    vector<Config> configs = buildConfigs(options);
+    size_t games = options.games;
+    unsigned int threads = (options.threads != 0) ? options.threads : max(1u, thread::hardware_concurrency());
+    fprintf(stderr, "sweep: %zu configurations x %zu games of at most %d ticks on %u threads\n",
+            configs.size(), games, options.maxTicks, threads);
+
+    // game g gets the same seed in every configuration, so configurations
+    // differ by their settings rather than by their luck
+    vector<uint64_t> seeds(games);
+    for (size_t g = 0; g < games; ++g)
+    {
+        PhiloxBlock bits = philox4x32(PhiloxBlock{{static_cast<uint32_t>(g), static_cast<uint32_t>(g >> 32), 0, 0}}, options.seed);
+        seeds[g] = (static_cast<uint64_t>(bits.word[1]) << 32) | bits.word[0];
+    }
+
+    // one game per chunk: games last anywhere from a few hundred ticks to maxTicks
+    vector<GameResult> results(configs.size() * games);
+    ThreadPool pool(threads);
+    pool.parallelFor(results.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            results[i] = playGame(configs[i / games], seeds[i % games], options.maxTicks);
+        }
+    });
+
+    fprintf(out, "level,oil_rate,human_rate,zombie_ped_rate,zombie_cab_rate,games,game_overs,"
+                 "mean_ticks,mean_score,mean_final_level,mean_peak_actors,max_peak_actors,"
+                 "tick_p50_ns,tick_p90_ns,tick_p99_ns,tick_p999_ns,tick_max_ns\n");
+    for (size_t c = 0; c < configs.size(); ++c)
+    {
+        writeRow(out, configs[c], &results[c * games], options.games);
+    }
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,16 @@
+#ifndef SWEEP_H_
+#define SWEEP_H_
+
+// Monte Carlo sweep over difficulty settings, run from the command line as
+// "GhostRacer -sweep [options]" without opening a window.
+
+/*
+ * Play seeded headless games, driven by the Autopilot, for every combination
+ * of starting level and spawn-rate multipliers given in argv, spread across
+ * cores, and write one CSV row per combination: how long the games lasted,
+ * what they scored, their peak actor count and percentiles of tick cost.
+ * Returns the process exit status.
+ */
+int runSweep(int argc, char *argv[]);
+
+#endif // SWEEP_H_
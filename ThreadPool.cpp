@@ -0,0 +1,140 @@
+#include "ThreadPool.h"
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned int threads)
+    : m_queues(threads < 1 ? 1 : threads), m_function(nullptr), m_context(nullptr), m_allocContext(), m_pending(0), m_generation(0), m_stopping(false)
+{
+    // participant 0 is whoever calls parallelFor
+    for (unsigned int i = 1; i < m_queues.size(); ++i)
+    {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+/* Deal the chunks out round-robin, wake the workers, and help until all are done */
+void ThreadPool::run(size_t count, size_t grain, ChunkFunction function, void *context)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (grain == 0)
+    {
+        grain = 1;
+    }
+    if (m_workers.empty() || count <= grain)
+    {
+        function(context, 0, count);
+        return;
+    }
+
+    // publish the job before any chunk of it can be taken; a worker still
+    // draining from the last job may pick new chunks up as soon as they land
+    size_t chunks = (count + grain - 1) / grain;
+    m_function = function;
+    m_context = context;
+    m_allocContext = AllocTracker::currentContext();
+    m_pending.store(chunks);
+    for (size_t c = 0; c < chunks; ++c)
+    {
+        size_t begin = c * grain;
+        size_t end = (begin + grain < count) ? begin + grain : count;
+        Queue &queue = m_queues[c % m_queues.size()];
+        lock_guard<mutex> lock(queue.mutex);
+        if (c < m_queues.size())
+        {
+            // queues are empty between jobs; drop the last job's spent entries
+            queue.chunks.clear();
+            queue.head = 0;
+        }
+        queue.chunks.push_back(Chunk{begin, end});
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    drain(0);
+
+    unique_lock<mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending.load() == 0; });
+}
+
+void ThreadPool::workerLoop(unsigned int index)
+{
+    unsigned long seen = 0;
+    for (;;)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || m_generation != seen; });
+            if (m_stopping)
+            {
+                return;
+            }
+            seen = m_generation;
+        }
+        drain(index);
+    }
+}
+
+/* Run chunks, own queue first, until there are none left anywhere */
+void ThreadPool::drain(unsigned int index)
+{
+    Chunk chunk;
+    while (take(index, chunk))
+    {
+        {
+            AllocContextScope allocContext(m_allocContext);
+            m_function(m_context, chunk.begin, chunk.end);
+        }
+        if (m_pending.fetch_sub(1) == 1)
+        {
+            // last chunk: wake the caller, under the lock so it can't miss it
+            lock_guard<mutex> lock(m_mutex);
+            m_done.notify_all();
+        }
+    }
+}
+
+bool ThreadPool::take(unsigned int index, Chunk &chunk)
+{
+    // newest chunk from our own queue
+    {
+        Queue &own = m_queues[index];
+        lock_guard<mutex> lock(own.mutex);
+        if (own.head < own.chunks.size())
+        {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+    // oldest chunk from someone else's
+    for (size_t offset = 1; offset < m_queues.size(); ++offset)
+    {
+        Queue &victim = m_queues[(index + offset) % m_queues.size()];
+        lock_guard<mutex> lock(victim.mutex);
+        if (victim.head < victim.chunks.size())
+        {
+            chunk = victim.chunks[victim.head++];
+            return true;
+        }
+    }
+    return false;
+}
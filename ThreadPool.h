@@ -0,0 +1,84 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include "AllocTracker.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fork-join pool for splitting a loop over many actors across cores. Each
+// participant has its own queue of chunks and steals from the others' when
+// it runs dry, so uneven chunks (zombies near the GR do more work) balance out.
+class ThreadPool
+{
+public:
+    // @param threads: participants including the calling thread; 1 runs everything inline
+    explicit ThreadPool(unsigned int threads);
+    ~ThreadPool();
+
+    unsigned int size() const { return static_cast<unsigned int>(m_queues.size()); }
+
+    /*
+     * Call fn(begin, end) over [0, count) in chunks of at most @param grain and
+     * return once every chunk is done. The caller works too. Chunks may run in
+     * any order on any thread, so fn must only write state its range owns.
+     */
+    template <typename F>
+    void parallelFor(size_t count, size_t grain, F &&fn)
+    {
+        typedef typename std::remove_reference<F>::type Function;
+        run(count, grain, &callChunk<Function>, const_cast<void *>(static_cast<const void *>(&fn)));
+    }
+
+private:
+    typedef void (*ChunkFunction)(void *context, size_t begin, size_t end);
+
+    struct Chunk
+    {
+        size_t begin;
+        size_t end;
+    };
+
+    // owner pops from the back, thieves take from the front
+    struct Queue
+    {
+        std::mutex mutex;
+        std::vector<Chunk> chunks;
+        size_t head = 0;
+    };
+
+    template <typename F>
+    static void callChunk(void *context, size_t begin, size_t end)
+    {
+        (*static_cast<F *>(context))(begin, end);
+    }
+
+    std::vector<Queue> m_queues;
+    std::vector<std::thread> m_workers;
+
+    // the job being run; only changed while no chunk is outstanding
+    ChunkFunction m_function;
+    void *m_context;
+    AllocTracker::Context m_allocContext; // the caller's, so workers' allocations count towards its tick
+    std::atomic<size_t> m_pending;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    unsigned long m_generation;
+    bool m_stopping;
+
+    void run(size_t count, size_t grain, ChunkFunction function, void *context);
+    void workerLoop(unsigned int index);
+    void drain(unsigned int index);
+    bool take(unsigned int index, Chunk &chunk);
+
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+};
+
+#endif // THREADPOOL_H_
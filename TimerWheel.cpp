@@ -0,0 +1,121 @@
+#include "TimerWheel.h"
+using namespace std;
+
+TimerWheel::TimerWheel(uint32_t now)
+{
+    reset(now);
+}
+
+void TimerWheel::reset(uint32_t now)
+{
+    for (List (&level)[SLOTS] : m_slots)
+    {
+        for (List &slot : level)
+        {
+            slot = List{NONE, NONE};
+        }
+    }
+    m_overflow = List{NONE, NONE};
+    // every timer is free again; clear keeps the pool's memory for the next ones
+    m_timers.clear();
+    m_free = NONE;
+    m_now = now;
+    m_size = 0;
+}
+
+void TimerWheel::schedule(uint32_t tick, ActorHandle handle)
+{
+    if (static_cast<int32_t>(tick - m_now) <= 0)
+    {
+        tick = m_now + 1;
+    }
+    place(acquire(tick, handle));
+    ++m_size;
+}
+
+/* A pool entry for a new timer: a freed one if there is one, otherwise the next past the end */
+uint32_t TimerWheel::acquire(uint32_t tick, ActorHandle handle)
+{
+    uint32_t index = m_free;
+    if (index != NONE)
+    {
+        m_free = m_timers[index].next;
+        m_timers[index] = Timer{tick, handle, NONE};
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_timers.size());
+        m_timers.push_back(Timer{tick, handle, NONE});
+    }
+    return index;
+}
+
+void TimerWheel::release(uint32_t index)
+{
+    m_timers[index].next = m_free;
+    m_free = index;
+}
+
+/* Append timer @param index to the lowest level whose span still reaches its tick */
+void TimerWheel::place(uint32_t index)
+{
+    Timer &timer = m_timers[index];
+    timer.next = NONE;
+    List *list = &m_overflow;
+    uint32_t delta = timer.tick - m_now;
+    for (unsigned int level = 0; level < LEVELS; ++level)
+    {
+        unsigned int shift = level * SLOT_BITS;
+        if (delta < (1u << (shift + SLOT_BITS)))
+        {
+            list = &m_slots[level][(timer.tick >> shift) & (SLOTS - 1)];
+            break;
+        }
+    }
+    if (list->tail == NONE)
+    {
+        list->head = index;
+    }
+    else
+    {
+        m_timers[list->tail].next = index;
+    }
+    list->tail = index;
+}
+
+/* On entering a new block of ticks, spread the slot above that covers it over the levels below */
+void TimerWheel::cascade()
+{
+    // top down, so a timer can fall more than one level at once
+    if ((m_now & ((1u << (LEVELS * SLOT_BITS)) - 1)) == 0)
+    {
+        replace(m_overflow);
+    }
+    for (unsigned int level = LEVELS - 1; level > 0; --level)
+    {
+        unsigned int shift = level * SLOT_BITS;
+        if ((m_now & ((1u << shift) - 1)) == 0)
+        {
+            replace(m_slots[level][(m_now >> shift) & (SLOTS - 1)]);
+        }
+    }
+}
+
+void TimerWheel::replace(List &list)
+{
+    // place may append to the overflow list we are reading from, so take it first
+    uint32_t index = take(list);
+    while (index != NONE)
+    {
+        uint32_t next = m_timers[index].next;
+        place(index);
+        index = next;
+    }
+}
+
+uint32_t TimerWheel::take(List &list)
+{
+    uint32_t head = list.head;
+    list = List{NONE, NONE};
+    return head;
+}
@@ -0,0 +1,93 @@
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include "ActorStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timing wheel (Varghese & Lauck) of actor wake-ups. Level 0 has
+// a slot for each of the next 64 ticks, and each level above a slot per 64
+// slots of the one below; wake-ups past the top level wait in an overflow
+// list. Scheduling is O(1), and a tick only touches the slot that is due,
+// plus a cascade from the level above once every 64 ticks. Timers live in
+// one pool, linked into their slot's list, so once the pool has grown to the
+// most wake-ups ever pending at once, scheduling doesn't allocate.
+class TimerWheel
+{
+public:
+    static const unsigned int SLOT_BITS = 6;
+    static const unsigned int SLOTS = 1u << SLOT_BITS;
+    static const unsigned int LEVELS = 3;
+
+    explicit TimerWheel(std::uint32_t now = 0);
+
+    // drop every wake-up; ticks up to @param now count as done
+    void reset(std::uint32_t now);
+    // wake @param handle on @param tick; a tick that isn't after now() means next tick
+    void schedule(std::uint32_t tick, ActorHandle handle);
+
+    std::uint32_t now() const { return m_now; }
+    size_t size() const { return m_size; }
+
+    /*
+     * Step forward to @param tick, calling f(handle) for every wake-up due on
+     * the way, tick by tick and in scheduling order within a tick. f may
+     * schedule more; those land on later ticks.
+     */
+    template <typename F>
+    void advance(std::uint32_t tick, F &&f)
+    {
+        while (static_cast<std::int32_t>(tick - m_now) > 0)
+        {
+            ++m_now;
+            cascade();
+            // take the slot's list so f can schedule without touching what we walk
+            std::uint32_t index = take(m_slots[0][m_now & (SLOTS - 1)]);
+            while (index != NONE)
+            {
+                // f may grow the pool, so copy out before calling it
+                ActorHandle handle = m_timers[index].handle;
+                std::uint32_t next = m_timers[index].next;
+                release(index);
+                --m_size;
+                f(handle);
+                index = next;
+            }
+        }
+    }
+
+private:
+    static const std::uint32_t NONE = ~0u;
+
+    struct Timer
+    {
+        std::uint32_t tick;
+        ActorHandle handle;
+        std::uint32_t next; // in its slot's list, or the free list
+    };
+
+    // first and last of a slot's timers, oldest first
+    struct List
+    {
+        std::uint32_t head;
+        std::uint32_t tail;
+    };
+
+    std::vector<Timer> m_timers; // the pool; only grows, and reset keeps its capacity
+    std::uint32_t m_free;        // first unused entry of m_timers below its size
+    List m_slots[LEVELS][SLOTS];
+    List m_overflow;
+    std::uint32_t m_now;
+    size_t m_size;
+
+    std::uint32_t acquire(std::uint32_t tick, ActorHandle handle);
+    void release(std::uint32_t index);
+    void place(std::uint32_t index);
+    void cascade();
+    void replace(List &list);
+    // empty @param list, returning its first timer
+    std::uint32_t take(List &list);
+};
+
+#endif // TIMERWHEEL_H_
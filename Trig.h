@@ -0,0 +1,88 @@
+#ifndef TRIG_H_
+#define TRIG_H_
+
+// Sine and cosine of every whole-degree angle, built at compile time.
+// Directions are whole degrees everywhere (GraphObject::getDirection), so
+// movement and sprite rotation look them up here rather than calling
+// std::sin and std::cos. Angles are reduced exactly, in whole degrees, so
+// entries are within an ulp of the true values and the right angles come out
+// exact: cosDegrees(90) is 0, where std::cos(M_PI / 2) is 6e-17.
+class TrigTable
+{
+public:
+    constexpr TrigTable() : m_sine(), m_cosine()
+    {
+        for (int degrees = 0; degrees < 360; ++degrees)
+        {
+            // fold into [0, 45] degrees, where the series converge fastest
+            int quadrant = degrees / 90;
+            int within = degrees % 90;
+            double s = (within <= 45) ? sineSeries(within) : cosineSeries(90 - within);
+            double c = (within <= 45) ? cosineSeries(within) : sineSeries(90 - within);
+            switch (quadrant)
+            {
+            case 0: m_sine[degrees] = s;  m_cosine[degrees] = c;  break;
+            case 1: m_sine[degrees] = c;  m_cosine[degrees] = -s; break;
+            case 2: m_sine[degrees] = -s; m_cosine[degrees] = -c; break;
+            default: m_sine[degrees] = -c; m_cosine[degrees] = s; break;
+            }
+        }
+    }
+
+    // @param degrees wrapped to [0, 360) first, so negative angles work too
+    constexpr double sine(int degrees) const { return m_sine[wrap(degrees)]; }
+    constexpr double cosine(int degrees) const { return m_cosine[wrap(degrees)]; }
+
+    static constexpr int wrap(int degrees)
+    {
+        int wrapped = degrees % 360;
+        return (wrapped < 0) ? wrapped + 360 : wrapped;
+    }
+
+private:
+    double m_sine[360];
+    double m_cosine[360];
+
+    static constexpr double RADIANS_PER_DEGREE = 3.14159265358979323846 / 180;
+    // enough Taylor terms that the next one is below an ulp for angles up to 45 degrees
+    static const int SERIES_TERMS = 12;
+
+    static constexpr double sineSeries(int degrees)
+    {
+        double x = degrees * RADIANS_PER_DEGREE;
+        double term = x, sum = 0;
+        for (int n = 1; n <= SERIES_TERMS; ++n)
+        {
+            sum += term;
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+        }
+        return sum;
+    }
+
+    static constexpr double cosineSeries(int degrees)
+    {
+        double x = degrees * RADIANS_PER_DEGREE;
+        double term = 1, sum = 0;
+        for (int n = 1; n <= SERIES_TERMS; ++n)
+        {
+            sum += term;
+            term *= -x * x / ((2 * n - 1) * (2 * n));
+        }
+        return sum;
+    }
+};
+
+// one table for the whole program
+inline constexpr TrigTable TRIG;
+
+constexpr double sinDegrees(int degrees)
+{
+    return TRIG.sine(degrees);
+}
+
+constexpr double cosDegrees(int degrees)
+{
+    return TRIG.cosine(degrees);
+}
+
+#endif // TRIG_H_
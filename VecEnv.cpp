@@ -0,0 +1,144 @@
+#include "VecEnv.h"
+#include "StudentWorld.h"
+#include "OccupancyGrid.h"
+#include "Random.h"
+#include <thread>
+using namespace std;
+
+namespace
+{
+    const int ACTION_KEYS[NUM_ENV_ACTIONS] = {0, KEY_PRESS_LEFT, KEY_PRESS_RIGHT, KEY_PRESS_UP, KEY_PRESS_DOWN, KEY_PRESS_SPACE};
+
+    // one pool participant per core unless told otherwise
+    unsigned int poolSize(unsigned int threads)
+    {
+        return (threads != 0) ? threads : max(1u, thread::hardware_concurrency());
+    }
+}
+
+/* Hand the world its action for this tick, once */
+bool VecEnv::Slot::getLastKey(int &value)
+{
+    if (key == 0)
+    {
+        return false;
+    }
+    value = key;
+    key = 0;
+    return true;
+}
+
+VecEnv::VecEnv(size_t worlds, uint64_t seed, unsigned int threads)
+    : m_pool(poolSize(threads)), m_seed(seed)
+{
+    for (size_t i = 0; i < worlds; ++i)
+    {
+        m_slots.emplace_back(new Slot());
+        Slot &slot = *m_slots.back();
+        slot.world.reset(new StudentWorld(""));
+        slot.world->setServices(&slot);
+        // the pool already spreads worlds over the cores
+        slot.world->setWorkerThreads(1);
+        slot.episode = 0;
+        slot.key = 0;
+    }
+}
+
+VecEnv::~VecEnv()
+{
+}
+
+StudentWorld &VecEnv::world(size_t i)
+{
+    return *m_slots[i]->world;
+}
+
+void VecEnv::reset(float *observations)
+{
+    m_pool.parallelFor(m_slots.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            newGame(i);
+            observe(i, observations + i * OBSERVATION_SIZE);
+        }
+    });
+}
+
+void VecEnv::step(const int *actions, float *observations, float *rewards, unsigned char *done)
+{
+    m_pool.parallelFor(m_slots.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            stepWorld(i, actions[i], observations + i * OBSERVATION_SIZE, rewards + i, done + i);
+        }
+    });
+}
+
+void VecEnv::observeGrids(unsigned char *grids)
+{
+    m_pool.parallelFor(m_slots.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            rasterizeOccupancy(m_slots[i]->world->store(), m_slots[i]->world->projectiles(), grids + i * GRID_CELLS);
+        }
+    });
+}
+
+/* Start world @param i on a new game, seeded by the env's seed, the world and how many games it has played */
+void VecEnv::newGame(size_t i)
+{
+    Slot &slot = *m_slots[i];
+    PhiloxBlock counter = {{static_cast<uint32_t>(i), static_cast<uint32_t>(i >> 32),
+                            static_cast<uint32_t>(slot.episode), static_cast<uint32_t>(slot.episode >> 32)}};
+    PhiloxBlock bits = philox4x32(counter, m_seed);
+    ++slot.episode;
+
+    slot.world->cleanUp();
+    slot.world->restartGame();
+    slot.world->setSeed((static_cast<uint64_t>(bits.word[1]) << 32) | bits.word[0]);
+    slot.world->init();
+}
+
+/* One tick of world @param i, restarting it the way the game would when the tick ends a life or level */
+void VecEnv::stepWorld(size_t i, int action, float *observation, float *reward, unsigned char *done)
+{
+    Slot &slot = *m_slots[i];
+    StudentWorld &world = *slot.world;
+    slot.key = (action > ACTION_NONE && action < NUM_ENV_ACTIONS) ? ACTION_KEYS[action] : 0;
+
+    int scoreBefore = world.getScore();
+    int status = world.move();
+    *reward = static_cast<float>(world.getScore() - scoreBefore);
+    *done = (status != GWSTATUS_CONTINUE_GAME);
+
+    if (status == GWSTATUS_PLAYER_DIED && world.isGameOver())
+    {
+        newGame(i);
+    }
+    else if (status == GWSTATUS_PLAYER_DIED || status == GWSTATUS_FINISHED_LEVEL)
+    {
+        if (status == GWSTATUS_FINISHED_LEVEL)
+        {
+            world.advanceToNextLevel();
+        }
+        world.cleanUp();
+        world.init();
+    }
+    observe(i, observation);
+}
+
+void VecEnv::observe(size_t i, float *observation)
+{
+    StudentWorld &world = *m_slots[i]->world;
+    const GhostRacer *gr = world.getGR();
+    const double halfRoad = (ROAD.rightEdge() - ROAD.leftEdge()) / 2;
+    const double halfTurn = GhostRacer::LEFT_ANGLE_TURN_LIMIT - GhostRacer::START_DIR;
+
+    observation[OBS_GR_X] = static_cast<float>((gr->getX() - ROAD_CENTER) / halfRoad);
+    observation[OBS_GR_DIRECTION] = static_cast<float>((gr->getDirection() - GhostRacer::START_DIR) / halfTurn);
+    observation[OBS_GR_SPEED] = static_cast<float>(gr->getVertSpeed() / GhostRacer::MAX_VERT_SPEED);
+    observation[OBS_GR_HEALTH] = static_cast<float>(gr->getHP()) / GhostRacer::INIT_HP;
+    observation[OBS_SPRAYS] = static_cast<float>(gr->getSprayCount()) / GhostRacer::INIT_WATER_COUNT;
+    observation[OBS_SOULS_LEFT] = static_cast<float>(world.soulsRequired()) / world.soulsForLevel();
+    observation[OBS_LIVES] = static_cast<float>(world.getLives()) / START_PLAYER_LIVES;
+}
@@ -0,0 +1,100 @@
+#ifndef VECENV_H_
+#define VECENV_H_
+
+#include "GameServices.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class StudentWorld;
+
+// What a driver can do on a tick; each is one key press
+enum EnvAction
+{
+    ACTION_NONE,
+    ACTION_LEFT,
+    ACTION_RIGHT,
+    ACTION_UP,
+    ACTION_DOWN,
+    ACTION_SPRAY,
+    NUM_ENV_ACTIONS
+};
+
+// Layout of one world's observation, scaled to roughly [-1, 1]
+enum EnvObservation
+{
+    OBS_GR_X,         // -1 at the left road edge, 1 at the right
+    OBS_GR_DIRECTION, // -1 turned fully right, 1 fully left
+    OBS_GR_SPEED,     // vertical speed over the maximum
+    OBS_GR_HEALTH,
+    OBS_SPRAYS,
+    OBS_SOULS_LEFT, // souls still needed to finish the level, over the level's total
+    OBS_LIVES,
+    NUM_ENV_OBSERVATIONS
+};
+
+/*
+ * A batch of independent headless StudentWorlds stepped in lockstep across a
+ * thread pool, for training and evaluating driving bots. Each world plays a
+ * normal game: losing a life or finishing a level restarts the level, and a
+ * game over starts a new game with a fresh seed, so every world always has a
+ * game in progress. Stepping writes into the caller's buffers and allocates
+ * nothing itself (actors the worlds spawn still come from the heap).
+ */
+class VecEnv
+{
+public:
+    static const size_t OBSERVATION_SIZE = NUM_ENV_OBSERVATIONS;
+
+    // @param threads: 0 uses every core; each world's own tick runs serially
+    VecEnv(size_t worlds, std::uint64_t seed, unsigned int threads = 0);
+    ~VecEnv();
+
+    size_t size() const { return m_slots.size(); }
+    StudentWorld &world(size_t i);
+
+    // start a new game in every world and write the first observations
+    void reset(float *observations);
+
+    /*
+     * Apply actions[i] (an EnvAction) to world i and advance every world one
+     * tick. Writes size() * OBSERVATION_SIZE observations, and per world the
+     * score gained as the reward and whether the tick ended a life, a level
+     * or the game. A world that is done has already been restarted, so its
+     * observation is the first of the next episode.
+     */
+    void step(const int *actions, float *observations, float *rewards, unsigned char *done);
+
+    // write every world's occupancy grid (OccupancyGrid.h), GRID_CELLS bytes each, into @param grids
+    void observeGrids(unsigned char *grids);
+
+private:
+    // one world plus the keyboard it reads its actions from
+    struct Slot : public GameServices
+    {
+        std::unique_ptr<StudentWorld> world;
+        std::uint64_t episode;
+        int key; // 0 when no key is pending
+
+        bool getLastKey(int &value) override;
+        void playSound(int) override {}
+        void setGameStatText(std::string_view) override {}
+        void setMsPerTick(int) override {}
+        void quitGame() override {}
+    };
+
+    std::vector<std::unique_ptr<Slot>> m_slots;
+    ThreadPool m_pool;
+    std::uint64_t m_seed;
+
+    void newGame(size_t i);
+    void stepWorld(size_t i, int action, float *observation, float *reward, unsigned char *done);
+    void observe(size_t i, float *observation);
+
+    VecEnv(const VecEnv &);
+    VecEnv &operator=(const VecEnv &);
+};
+
+#endif // VECENV_H_
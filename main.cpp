@@ -1,7 +1,13 @@
 #include "GameController.h"
+#include "GameWorld.h"
+#include "AllocTracker.h"
+#include "Bench.h"
+#include "Sweep.h"
+#include "Autopilot.h"
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <memory>
 #include <cstdlib>
 #include <ctime>
 using namespace std;
@@ -31,9 +37,17 @@ const string assetDirectory = "Assets";
 class GameWorld;
 
 GameWorld* createStudentWorld(string assetPath = "");
+GameWorld* createHordeWorld(string assetPath = "");
 
 int main(int argc, char* argv[])
 {
+	  // benchmarks run headless and don't need the assets; like the game,
+	  // they fail if any tick went over GHOSTRACER_ALLOC_BUDGET
+	if (argc > 1  &&  string(argv[1]) == "-bench")
+		return (runBench(argc - 2, argv + 2) != 0  ||  AllocTracker::budgetExceeded()) ? 1 : 0;
+	if (argc > 1  &&  string(argv[1]) == "-sweep")
+		return (runSweep(argc - 2, argv + 2) != 0  ||  AllocTracker::budgetExceeded()) ? 1 : 0;
+
     string assetPath = assetDirectory;
     if (!assetPath.empty())
     {
@@ -57,6 +71,25 @@ int main(int argc, char* argv[])
 
 	srand(static_cast<unsigned int>(time(nullptr)));
 
-	GameWorld* gw = createStudentWorld(assetPath);
+	bool horde = false;
+	bool autopilot = false;
+	for (int i = 1; i < argc; i++)
+	{
+		  // -horde floods the road with zombies to stress the engine
+		horde = horde  ||  string(argv[i]) == "-horde";
+		  // -autopilot lets the built-in bot drive; the window still shows the game
+		autopilot = autopilot  ||  string(argv[i]) == "-autopilot";
+	}
+
+	GameWorld* gw = horde ? createHordeWorld(assetPath) : createStudentWorld(assetPath);
+	unique_ptr<GameServices> pilot;
+	if (autopilot)
+	{
+		pilot.reset(createAutopilot(gw, &Game()));
+		gw->setServices(pilot.get());
+	}
 	Game().run(argc, argv, gw, "Ghost Racer");
+
+	  // lets CI fail a run whose ticks went over GHOSTRACER_ALLOC_BUDGET
+	return AllocTracker::budgetExceeded() ? 1 : 0;
 }